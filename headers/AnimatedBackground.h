@@ -6,21 +6,53 @@
 #include <string>
 #include <chrono>
 
+// loops frame0..frameN-1 from a folder. frames are decoded in parallel at
+// startup (AssetLoader jobs running decodeFrame) and packed into one sprite
+// sheet texture, so a frame is just a different source rect. if the sheet is
+// bigger than the gpu allows, one streaming texture is refilled from the
+// decoded frames whenever the frame changes
 class AnimatedBackground {
 public:
-    AnimatedBackground(SDL_Renderer* renderer, const std::string& folder, int frameCount, int frameDelayMs);
+    // frames from decodeFrame, takes ownership, null entries are skipped
+    AnimatedBackground(SDL_Renderer* renderer, std::vector<SDL_Surface*> frames, int frameDelayMs);
     ~AnimatedBackground();
 
+    // folder/frame<index>.png as rgba32, safe on any thread. null on failure
+    static SDL_Surface* decodeFrame(const std::string& folder, int index);
+
     void update();
     void render();
 
+    struct MemoryUsage {
+        size_t textureBytes; // gpu side, sheet or streaming texture
+        size_t cpuBytes;     // decoded frames kept around for streaming
+    };
+    MemoryUsage getMemoryUsage() const;
+    bool isStreaming() const { return streamTexture_ != nullptr; }
+    int getFrameCount() const { return frameCount_; }
+
 private:
     SDL_Renderer* renderer_;
-    std::vector<SDL_Texture*> frames_;
     int currentFrame_;
     int frameCount_;
     int frameDelayMs_;
     std::chrono::steady_clock::time_point lastUpdate_;
+
+    int frameW_, frameH_;
+
+    // sprite sheet mode
+    SDL_Texture* sheet_;
+    int sheetW_, sheetH_;
+    std::vector<SDL_Rect> frameRects_;
+
+    // streaming mode
+    SDL_Texture* streamTexture_;
+    std::vector<SDL_Surface*> decoded_;
+    int uploadedFrame_;
+
+    void build(std::vector<SDL_Surface*>& frames);
+    bool buildSheet(const std::vector<SDL_Surface*>& frames);
+    bool buildStream(std::vector<SDL_Surface*>& frames);
 };
 
 #endif
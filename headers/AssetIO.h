@@ -0,0 +1,56 @@
+#ifndef ASSET_IO_H
+#define ASSET_IO_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// every asset file is opened through here. when the packed archive built by
+// `make pak` is mounted, files come straight out of the memory mapped archive
+// through SDL_RWFromConstMem (one open, no copies), anything not in it falls
+// back to the loose file on disk. lookups are read only so any thread can open
+class AssetIO {
+public:
+    // archive layout, little endian, written by tools/AssetPacker.cpp:
+    //   magic[8] entryCount:u32
+    //   entryCount x { pathLength:u16 path[pathLength] offset:u64 size:u64 }
+    //   file data, each file starting on a DATA_ALIGN boundary
+    static constexpr char MAGIC[8] = {'R', 'K', 'P', 'A', 'K', '0', '1', '\0'};
+    static constexpr size_t DATA_ALIGN = 16;
+
+    // maps the archive, false if it is missing or broken (loose files are used then)
+    static bool mount(const std::string& archivePath);
+    static void unmount();
+    static bool isMounted() { return data_ != nullptr; }
+    static size_t getEntryCount() { return index_.size(); }
+
+    // read only stream over the file, null if it exists nowhere.
+    // hand it to the *_RW loaders with freesrc = 1 or SDL_RWclose it
+    static SDL_RWops* open(const std::string& path);
+
+    // whole file, for small text files like the atlas manifest
+    static bool readFile(const std::string& path, std::string& contents);
+
+    // size and last write time of whatever open(path) would read, for cache keys.
+    // archived files report the archive's write time
+    static bool getFileInfo(const std::string& path, uint64_t& size, int64_t& modified);
+
+private:
+    struct Entry {
+        size_t offset;
+        size_t size;
+    };
+
+    static const unsigned char* data_;
+    static size_t size_;
+    static bool mapped_;                    // false when the file had to be read into buffer_
+    static std::vector<unsigned char> buffer_;
+    static std::unordered_map<std::string, Entry> index_;
+    static int64_t archiveModified_;
+
+    static bool readIndex();
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+class AssetManager;
+
+// startup loading on a small worker pool. each job has a work step that runs
+// on a worker (file io, png/mp3 decode) and an optional finish step that runs
+// on the render thread from pump() (gpu upload), so the window can keep
+// drawing a loading screen while everything decodes in parallel
+class AssetLoader {
+public:
+    // 0 threads picks one less than the core count, the render thread is the last one
+    explicit AssetLoader(int threadCount = 0);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // work returns false on failure, finish is skipped then
+    void add(std::function<bool()> work, std::function<void()> finish = nullptr);
+
+    // decode on a worker, upload into the AssetManager cache on the render thread.
+    // atlas sprites queue their page once no matter how many are added
+    void addTexture(AssetManager& assets, const std::string& path);
+
+    // runs finish steps of completed jobs, call from the render thread every frame.
+    // waits up to waitMs for something to complete if nothing has yet
+    void pump(int waitMs = 0);
+
+    bool isDone() const;
+    float getProgress() const; // 0..1, jobs fully finished over jobs added
+    int getFailedCount() const;
+    int getThreadCount() const { return static_cast<int>(workers_.size()); }
+
+private:
+    struct Job {
+        std::function<bool()> work;
+        std::function<void()> finish;
+        bool succeeded;
+    };
+
+    std::vector<std::thread> workers_;
+    mutable std::mutex mutex_;
+    std::condition_variable workReady_;
+    std::condition_variable jobDone_;
+    std::deque<Job*> queued_;     // waiting for a worker
+    std::vector<Job*> completed_; // work done, finish not run yet
+    std::vector<Job*> jobs_;      // owns every job, freed in the destructor
+    int finished_;
+    int failed_;
+    bool stopping_;
+
+    std::unordered_set<std::string> queuedTextures_;
+
+    void workerLoop();
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef ASSET_MANAGER_H
+#define ASSET_MANAGER_H
+
+#include <SDL2/SDL.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct TextureAsset;
+
+// reference counted, the texture is freed when the last holder lets go
+using TextureHandle = std::shared_ptr<TextureAsset>;
+
+// one decoded + uploaded image, shared by every entity that draws it.
+// can also be a region of the sprite atlas, then source is where it sits
+// in the atlas texture and page keeps that texture alive
+struct TextureAsset {
+    SDL_Texture* texture = nullptr;
+    int width = 0;    // size of the source image, entities scale from this
+    int height = 0;
+
+    SDL_Rect source = {0, 0, 0, 0};       // region of texture to draw
+    int textureWidth = 0;                 // size of the whole texture, for uv math
+    int textureHeight = 0;
+    TextureHandle page;                   // owner of texture when this is an atlas region
+    std::vector<TextureHandle> levels;    // pre-downscaled copies, levels[0] is half size
+
+    TextureAsset() = default;
+    TextureAsset(const TextureAsset&) = delete;
+    TextureAsset& operator=(const TextureAsset&) = delete;
+    ~TextureAsset();
+};
+
+// pixels of one image plus its downscaled levels, not on the gpu yet.
+// decoding only touches surfaces so it can run off the render thread
+struct DecodedImage {
+    std::vector<SDL_Surface*> levels; // full size first, then each half
+
+    DecodedImage() = default;
+    DecodedImage(const DecodedImage&) = delete;
+    DecodedImage& operator=(const DecodedImage&) = delete;
+    ~DecodedImage();
+};
+
+class AssetManager {
+public:
+    // with a null renderer (headless) nothing is decoded or uploaded,
+    // handles only carry the image size read from the png header.
+    // otherwise the sprite atlas manifest is read if `make atlas` built one,
+    // and any path listed there is served as a region of the atlas texture
+    AssetManager(SDL_Renderer* renderer);
+    ~AssetManager();
+
+    // first call for a path loads it, every call after that is just a lookup
+    TextureHandle getTexture(const std::string& path);
+
+    // load ahead of time so gameplay never touches the disk
+    bool preload(const std::string& path);
+
+    // split version of getTexture for AssetLoader: decodeImage is safe on any
+    // thread, addDecoded uploads on the render thread and caches under path.
+    // withLevels false skips the downscaled copies, atlas pages carry their own
+    static bool decodeImage(const std::string& path, DecodedImage& image, bool withLevels = true);
+    TextureHandle addDecoded(const std::string& path, const DecodedImage& image);
+    // file that actually has to be decoded for path, the atlas page for packed sprites
+    std::string getSourceFile(const std::string& path) const;
+    bool isCached(const std::string& path) const { return textures_.count(path) != 0; }
+    bool isAtlasPage(const std::string& path) const { return atlasPages_.count(path) != 0; }
+
+    // smallest pre-downscaled level still at least drawW x drawH, so nothing
+    // gets magnified. entities call this once when they know their size
+    static TextureHandle levelFor(const TextureHandle& texture, int drawW, int drawH);
+
+    size_t getCachedCount() const { return textures_.size(); }
+    bool hasAtlas() const { return !atlasRegions_.empty(); }
+
+private:
+    SDL_Renderer* renderer_;
+    std::unordered_map<std::string, TextureHandle> textures_;
+
+    // from the atlas manifest: sprite path -> page path + rect inside it,
+    // plus where the packer put its downscaled variants on the same page
+    struct AtlasRegion {
+        std::string page;
+        SDL_Rect rect;
+        std::vector<SDL_Rect> levels; // levels[0] is half size, like TextureAsset::levels
+    };
+    std::unordered_map<std::string, AtlasRegion> atlasRegions_;
+    std::unordered_set<std::string> atlasPages_;
+
+    void loadAtlasManifest(const std::string& manifestPath);
+    TextureHandle loadTexture(const std::string& path);
+    TextureHandle loadRegion(const AtlasRegion& region);
+    TextureHandle makeRegion(const TextureHandle& page, const SDL_Rect& rect);
+    TextureHandle uploadSurface(SDL_Surface* surface);
+    TextureHandle uploadDecoded(const std::string& path, const DecodedImage& image);
+    TextureHandle loadSizeOnly(const std::string& path);
+};
+
+#endif
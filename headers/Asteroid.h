@@ -2,29 +2,28 @@
 #define ASTEROID_H
 
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
-#include <string>
+#include "AssetManager.h"
 
+class Random;
+
+// one freshly rolled asteroid (random size, spin, side and speed), rolled from
+// the game's own rng so a seed always gives the same asteroids.
+// AsteroidField copies it into its arrays on spawn and simulates it from there
 class Asteroid {
 public:
-    Asteroid(SDL_Renderer* renderer, const std::string& texturePath, int screenW, int screenH, float playerX, float playerY);
-    ~Asteroid();
-
-    void update(float deltaTime, float playerX, float playerY);
-    void render();
-    bool isOffScreen() const;
+    Asteroid(TextureHandle texture, Random& rng, int screenW, int screenH, float playerX, float playerY);
 
     const SDL_Rect& getRect() const { return rect_; }  // hitbox init
 
 private:
-    SDL_Renderer* renderer_;
-    SDL_Texture* texture_;
+    friend class AsteroidField;
+
+    TextureHandle texture_; // shared through the AssetManager cache
     SDL_Rect rect_;
     float x_, y_;
     float vx_, vy_;
     float speed_;
     float angle_, rotationSpeed_;
-    int screenW_, screenH_;
 };
 
 #endif
@@ -0,0 +1,67 @@
+#ifndef ASTEROID_FIELD_H
+#define ASTEROID_FIELD_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "AssetManager.h"
+#include "Asteroid.h"
+#include "EntityPool.h"
+#include "GameSnapshot.h"
+
+// every live asteroid, stored structure-of-arrays style so the per tick
+// update walks a handful of contiguous float arrays instead of objects.
+// same rules as EntityPool: fixed capacity, despawn swaps the last one in
+class AsteroidField {
+public:
+    AsteroidField(size_t capacity, int screenW, int screenH);
+
+    // copies the rolled asteroid in, false when the field is full
+    bool spawn(const Asteroid& asteroid);
+    void despawn(size_t index);
+    void clear();
+
+    // homing, integration and angle wrap for every asteroid
+    void update(float deltaTime, float playerX, float playerY);
+    // same as update but only for [begin, end), lets callers split the work
+    void updateRange(size_t begin, size_t end, float deltaTime, float playerX, float playerY);
+
+    void removeOffScreen();
+    // one sprite per asteroid, with the previous tick position for interpolation
+    void appendSprites(std::vector<SpriteState>& sprites) const;
+
+    SDL_Rect getRect(size_t index) const {
+        return SDL_Rect{static_cast<int>(x_[index]), static_cast<int>(y_[index]), w_[index], h_[index]};
+    }
+    bool isOffScreen(size_t index) const;
+    float getX(size_t index) const { return x_[index]; }
+    float getY(size_t index) const { return y_[index]; }
+    float getAngle(size_t index) const { return angle_[index]; }
+
+    size_t size() const { return count_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return count_ == 0; }
+    PoolStats getStats() const { return PoolStats{count_, capacity_, highWaterMark_, droppedSpawns_}; }
+
+    // name of the update kernel compiled in (avx, sse2 or scalar)
+    static const char* getKernelName();
+
+private:
+    size_t count_;
+    size_t capacity_;
+    size_t highWaterMark_;
+    size_t droppedSpawns_;
+    int screenW_, screenH_;
+
+    // hot data, touched every tick
+    std::vector<float> x_, y_;
+    std::vector<float> prevX_, prevY_; // positions before the last update, for interpolation
+    std::vector<float> vx_, vy_;
+    std::vector<float> speed_;
+    std::vector<float> angle_, rotationSpeed_;
+
+    // cold data, only needed for hitboxes and drawing
+    std::vector<int> w_, h_;
+    std::vector<TextureHandle> textures_;
+};
+
+#endif
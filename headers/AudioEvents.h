@@ -0,0 +1,52 @@
+#ifndef AUDIO_EVENTS_H
+#define AUDIO_EVENTS_H
+
+#include <cstddef>
+#include <vector>
+
+enum class SoundEffect {
+    Shot,
+    Impact,  // bullet hit an asteroid
+    Death,   // asteroid hit the player
+};
+
+// one sound to play this frame. screen position decides pan and distance,
+// count is how many triggers were merged into it
+struct AudioEvent {
+    SoundEffect effect;
+    float x, y;
+    int count;
+};
+
+// sounds Game wants played, collected over every tick of a frame and handed
+// to Sounds::playEvents() once. the same effect triggered close to an earlier
+// one merges into it instead of taking another mixer voice, so a burst of
+// hits is one louder sound instead of a dozen stacked copies
+class AudioEventQueue {
+public:
+    explicit AudioEventQueue(size_t capacity);
+
+    void push(SoundEffect effect, float x, float y);
+    void clear();
+
+    // the listener is the player, sounds are panned and attenuated around it
+    void setListener(float x, float y) { listenerX_ = x; listenerY_ = y; }
+    float getListenerX() const { return listenerX_; }
+    float getListenerY() const { return listenerY_; }
+
+    const std::vector<AudioEvent>& getEvents() const { return events_; }
+    bool empty() const { return events_.empty(); }
+
+    // triggers folded into an earlier event, and ones dropped because the queue was full
+    size_t getCoalescedCount() const { return coalesced_; }
+    size_t getDroppedCount() const { return dropped_; }
+
+private:
+    std::vector<AudioEvent> events_; // reserved to capacity, pushing never allocates
+    size_t capacity_;
+    size_t coalesced_;
+    size_t dropped_;
+    float listenerX_, listenerY_;
+};
+
+#endif
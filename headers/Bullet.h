@@ -2,24 +2,24 @@
 #define BULLET_H
 
 #include <SDL2/SDL.h>
-#include <string>
+#include "AssetManager.h"
+#include "GameSnapshot.h"
 
 class Bullet {
 public:
-    Bullet(SDL_Renderer* renderer, const std::string& path, float startX, float startY, float targetX, float targetY);
-    ~Bullet();
+    Bullet(TextureHandle texture, float startX, float startY, float targetX, float targetY);
 
     void update(float deltaTime);
-    void render();
+    bool getSprite(SpriteState& sprite) const; // how to draw it this tick, false if there is nothing to draw
     bool isOffScreen() const;
 
     const SDL_Rect& getRect() const { return rect_; }
 
 private:
-    SDL_Renderer* renderer_;
-    SDL_Texture* texture_;
+    TextureHandle texture_; // shared with every other bullet
     SDL_Rect rect_;
     float x_, y_;
+    float prevX_, prevY_; // position before the last update, for interpolation
     float vx_, vy_;
     float speed_;
     float angle;
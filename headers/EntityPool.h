@@ -0,0 +1,74 @@
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// numbers for tuning the pool capacities in GameConstants
+struct PoolStats {
+    size_t size;
+    size_t capacity;
+    size_t highWaterMark;   // most entities alive at once since the pool was created
+    size_t droppedSpawns;   // spawns refused because the pool was full
+};
+
+// fixed capacity storage, entities live by value in one contiguous block.
+// memory is reserved up front so spawning never allocates, and despawn
+// swaps the last entity into the hole so removal is O(1).
+// despawning changes the order of the remaining entities!
+template <typename T>
+class EntityPool {
+public:
+    explicit EntityPool(size_t capacity)
+        : capacity_(capacity), highWaterMark_(0), droppedSpawns_(0) {
+        items_.reserve(capacity_);
+    }
+
+    // returns nullptr when full
+    template <typename... Args>
+    T* spawn(Args&&... args) {
+        if (items_.size() >= capacity_) {
+            ++droppedSpawns_;
+            return nullptr;
+        }
+
+        items_.emplace_back(std::forward<Args>(args)...);
+        if (items_.size() > highWaterMark_) highWaterMark_ = items_.size();
+        return &items_.back();
+    }
+
+    void despawn(size_t index) {
+        if (index + 1 != items_.size()) {
+            items_[index] = std::move(items_.back());
+        }
+        items_.pop_back();
+    }
+
+    void clear() { items_.clear(); }
+
+    size_t size() const { return items_.size(); }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return items_.empty(); }
+    bool full() const { return items_.size() >= capacity_; }
+
+    T& operator[](size_t index) { return items_[index]; }
+    const T& operator[](size_t index) const { return items_[index]; }
+
+    typename std::vector<T>::iterator begin() { return items_.begin(); }
+    typename std::vector<T>::iterator end() { return items_.end(); }
+    typename std::vector<T>::const_iterator begin() const { return items_.begin(); }
+    typename std::vector<T>::const_iterator end() const { return items_.end(); }
+
+    PoolStats getStats() const {
+        return PoolStats{items_.size(), capacity_, highWaterMark_, droppedSpawns_};
+    }
+
+private:
+    std::vector<T> items_;
+    size_t capacity_;
+    size_t highWaterMark_;
+    size_t droppedSpawns_;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+#include <SDL2/SDL.h>
+
+// turns real frame time into a whole number of fixed simulation ticks.
+// leftover time carries to the next frame and doubles as the render
+// interpolation factor. a long hitch is capped at maxStepsPerFrame ticks,
+// the rest is thrown away so the game slows down instead of spiralling
+class FixedTimestep {
+public:
+    FixedTimestep(int tickRate, int maxStepsPerFrame);
+
+    // call once per frame, returns how many ticks to run right now
+    int advance();
+
+    // forget accumulated time, e.g. after a loading pause
+    void reset();
+
+    float getStepSeconds() const { return static_cast<float>(stepSeconds_); }
+
+    // 0..1, how far the current frame is between the last tick and the next
+    float getAlpha() const { return static_cast<float>(accumulator_ / stepSeconds_); }
+
+    // time left until advance() would return a tick, for threads that sleep between ticks
+    double getSecondsUntilNextStep() const;
+
+    // ticks skipped because a frame needed more than maxStepsPerFrame
+    Uint64 getDroppedSteps() const { return droppedSteps_; }
+
+private:
+    double stepSeconds_;
+    int maxStepsPerFrame_;
+    double counterToSeconds_;
+    Uint64 lastCounter_;
+    double accumulator_;
+    Uint64 droppedSteps_;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <SDL2/SDL.h>
+
+struct FramePacingStats {
+    Uint64 frames;        // intervals measured, present to present
+    float averageMs;
+    float jitterMs;       // standard deviation of the interval
+    float worstMs;
+    Uint64 missedFrames;  // intervals longer than 1.5 target periods, only counted while limiting
+    float sleptMs;        // total time handed back to the os sleeping
+    float spunMs;         // total time busy waiting the last bit before a deadline
+    float spinMarginUs;   // current margin, about twice the measured oversleep
+};
+
+// holds the main loop to a target frame rate instead of letting it spin at
+// thousands of fps. waiting is hybrid: a sleep for most of the gap, since
+// that frees the core but the os can wake us late, then a short yielding
+// spin on the performance counter to land on the deadline. the spin margin
+// adapts to how late wakeups actually are, so it stays a few hundred us on
+// an idle machine. deadlines
+// are a fixed schedule, not "period after the last frame", so oversleeping
+// one frame is paid back on the next and the average rate stays exact.
+// with a target of 0 nothing waits (vsync does the pacing) and only the
+// interval stats are kept
+class FramePacer {
+public:
+    explicit FramePacer(int targetFps = 0);
+
+    void setTargetFps(int targetFps);
+    int getTargetFps() const { return targetFps_; }
+
+    // call once per frame right after present, returns after the next deadline
+    void wait();
+
+    FramePacingStats getStats() const;
+
+private:
+    int targetFps_;
+    Uint64 period_;         // performance counter ticks per frame, 0 when not limiting
+    Uint64 spinMargin_;     // last stretch before a deadline that is spun, not slept
+    double oversleepTicks_; // running average of how late a sleep wakes up
+    Uint64 frequency_;
+    Uint64 nextDeadline_;
+    Uint64 lastFrame_;
+
+    // running interval stats, sums in ms so they stay small
+    Uint64 frames_;
+    double sumMs_;
+    double sumSquaresMs_;
+    double worstMs_;
+    Uint64 missedFrames_;
+    Uint64 sleptTicks_;
+    Uint64 spunTicks_;
+
+    void recordInterval(Uint64 now);
+    void updateSpinMargin();
+};
+
+#endif
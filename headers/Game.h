@@ -2,50 +2,130 @@
 #define GAME_H
 
 #include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 #include <string>
+#include "EntityPool.h"
+#include "AsteroidField.h"
+#include "Bullet.h"
+#include "SpatialGrid.h"
+#include "InputState.h"
+#include "SpriteBatch.h"
+#include "AudioEvents.h"
+#include "Random.h"
+#include "GameSnapshot.h"
 
 class Player;
-class Asteroid;
-class Bullet;
 class AnimatedBackground;
 class RoundManager;
 class UIRenderer;
 class Sounds;
+class AssetManager;
+class InputRecorder;
+class JobSystem;
 
 class Game {
 public:
  
-    Game(SDL_Renderer* renderer, int screenWidth, int screenHeight, Sounds* sounds);
+    // a null renderer runs the simulation headless: no textures, fonts or drawing.
+    // assets can be shared with the loader/start screen, otherwise Game makes its own
+    Game(SDL_Renderer* renderer, int screenWidth, int screenHeight, Sounds* sounds,
+         AssetManager* assets = nullptr);
     ~Game();
     void initialize();
+    // safe to call while another thread is in update(), see SimulationThread
     void handleEvent(const SDL_Event& event);
+    // replaces the pending input wholesale, used by headless/scripted runs
+    void setInput(const InputState& input);
+
+    // every initialize() restarts the rng from this seed, so seed + the
+    // per tick inputs fully decide a game
+    void setSeed(uint64_t seed) { seed_ = seed; }
+    uint64_t getSeed() const { return seed_; }
+    // gets the input applied on every tick from now on, null stops recording
+    void setRecorder(InputRecorder* recorder) { recorder_ = recorder; }
+    // splits the asteroid step and bullet collisions over the pool, null runs them inline.
+    // the results are the same either way
+    void setJobSystem(JobSystem* jobs) { jobs_ = jobs; }
+    // fingerprint of the simulation state, a replay matching the live run ends on the same value
+    uint64_t getStateHash() const;
 
     bool update(float deltaTime);
-    void render();
+    // plays the sounds queued by every update() since the last call
+    void flushAudio();
+    // copies what the renderer needs out of the current state, on the thread that runs update()
+    void captureSnapshot(GameSnapshot& snapshot) const;
+    // draws a snapshot, never the live state, so it can run while the next tick is simulated.
+    // alpha is how far between the snapshot's last two ticks to draw entities
+    void render(const GameSnapshot& snapshot, float alpha = 1.0f);
     bool isGameStarted() const { return gameStarted_; }
+    bool isGameOver() const { return gameOver_; }
+    int getCurrentRound() const;
     void spawnAsteroid(const std::string& texturePath, float playerX, float playerY);
 
+    PoolStats getBulletPoolStats() const { return bullets_.getStats(); }
+    PoolStats getAsteroidPoolStats() const { return asteroids_.getStats(); }
+
+    // asteroids + bullets drawn last frame and how many draw calls that took
+    int getLastSpriteCount() const { return spriteBatch_.getSpriteCount(); }
+    int getLastDrawCalls() const { return spriteBatch_.getDrawCalls(); }
+
 private:
+    friend struct GameBenchAccess; // tools/Bench.cpp times the private steps one by one
+
     SDL_Renderer* renderer_;
     int screenWidth_;
     int screenHeight_;
     Sounds* sounds_;
     
+    AssetManager* assets_;
+    bool ownsAssets_;
     Player* player_;
     RoundManager* roundManager_;
     UIRenderer* uiRenderer_;
     
-    std::vector<Bullet*> bullets_;
-    std::vector<Asteroid*> asteroids_;
+    EntityPool<Bullet> bullets_;
+    AsteroidField asteroids_;
+
+    SpriteBatch spriteBatch_;
+
+    // shots, hits and deaths from update(), played together by flushAudio()
+    AudioEventQueue audioEvents_;
+
+    // broadphase, rebuilt after asteroids move each tick
+    SpatialGrid collisionGrid_;
+
+    JobSystem* jobs_;
+
+    // per frame hit flags, reserved to pool capacity so collisions dont allocate
+    std::vector<unsigned char> bulletHits_;
+    std::vector<unsigned char> asteroidHits_;
+    std::vector<size_t> bulletTargets_; // lowest asteroid each bullet touches, before bullets compete
     
-    bool gameStarted_;
-    bool gameOver_;
+    std::mutex inputMutex_;   // events come in on the main thread, update() may run on another
+    InputState pendingInput_; // applied at the start of the next update
+    InputRecorder* recorder_;
+
+    Random rng_;     // everything random in the simulation rolls from this, never rand()
+    uint64_t seed_;
+
+    std::string roundLabel_;  // "Round N", rebuilt only when the round changes
+    int roundLabelRound_;
+
+    std::atomic<bool> gameStarted_;
+    std::atomic<bool> gameOver_;
 
     void updateBullets(float deltaTime);
     void updateAsteroids(float deltaTime);
+    // flags hits only, removeDestroyed() takes them out once the player check is done
     void checkBulletAsteroidCollisions();
+    // lowest index asteroid the bullet overlaps, asteroids_.size() if none.
+    // skipHit passes over asteroids already flagged in asteroidHits_
+    size_t findBulletTarget(size_t bullet, bool skipHit) const;
     bool checkPlayerAsteroidCollisions();
+    void removeDestroyed();
     void cleanup();
     void clearBullets();
 };
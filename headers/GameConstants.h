@@ -17,24 +17,62 @@ namespace GameConstants {
     constexpr float ROUND_TRANSITION_DURATION = 2.0f;
     constexpr int ASTEROIDS_PER_SPAWN_EVENT = 2;
 
+    // entity pool capacities, spawns past these are dropped (see Game::get*PoolStats)
+    constexpr int MAX_BULLETS = 512;
+    constexpr int MAX_ASTEROIDS = 1024;
+
+    // broadphase cell size in pixels, roughly one mid sized asteroid
+    constexpr int COLLISION_CELL_SIZE = 128;
+
+    // pre-downscaled halves made per texture at load time (1/2, 1/4, 1/8, 1/16),
+    // sprites are drawn at 0.2-0.5 scale so the full size is almost never sampled
+    constexpr int TEXTURE_MIP_LEVELS = 4;
+
     // font paths and variables
     constexpr const char* FONT_PATH = "assets/menufont.ttf";
     constexpr int ROUND_DISPLAY_FONT_SIZE = 36;
     constexpr int ROUND_TRANSITION_FONT_SIZE = 72;
+    constexpr int PROFILER_FONT_SIZE = 16;
 
     // asset paths
     constexpr const char* PLAYER_TEXTURE_PATH = "assets/player.png";
     constexpr const char* ASTEROID_TEXTURE_PATH = "assets/asteroid.png";
     constexpr const char* ASTEROID2_TEXTURE_PATH = "assets/asteroid2.png";
+    constexpr const char* BULLET_TEXTURE_PATH = "assets/bullet.png";
+    constexpr const char* ATLAS_MANIFEST_PATH = "assets/atlas.manifest"; // built by `make atlas`
+    constexpr const char* ASSET_ARCHIVE_PATH = "assets.pak";              // built by `make pak`, optional
+    constexpr const char* PIXEL_CACHE_DIR = "cache/pixels";               // decoded pngs, safe to delete
     constexpr const char* BACKGROUND_FOLDER_PATH = "assets/background";
     constexpr const char* MUSIC_PATH = "assets/backgroundmusic.mp3";
     constexpr const char* GUN_SOUND_PATH = "assets/gunsound.mp3";
+    constexpr const char* PROFILE_CSV_PATH = "profile.csv";                // frame timings, written on exit when profiling
+    constexpr const char* TRACE_PATH = "trace.json";                       // chrome trace, written on F4 and on exit when tracing
+    constexpr int MUSIC_STREAM_BUFFER_MS = 2000; // decoded music kept ahead of playback, its whole memory budget
+
+    // sound effects are queued during update and played once per frame
+    constexpr int MAX_AUDIO_EVENTS = 16;              // distinct sounds per frame, more than the mixer has voices anyway
+    constexpr float AUDIO_COALESCE_RADIUS = 96.0f;    // same effect this close in one frame plays as one sound
 
     // settings
     constexpr float PLAYER_SCALE = 0.20f;
-    constexpr int BACKGROUND_FRAME_COUNT = 9;
+    constexpr int BACKGROUND_FRAME_COUNT = 10; // frame0..frame9
     constexpr int BACKGROUND_FRAME_DELAY_MS = 100;
 
+    // simulation runs in fixed steps, rendering interpolates between them
+    constexpr int SIMULATION_TICK_RATE = 120; // ticks per second, --tick-rate overrides
+    constexpr int MAX_CATCHUP_STEPS = 8;      // most ticks run in one frame after a hitch
+    constexpr int SIMULATION_SPIN_US = 200;   // the simulation thread yields instead of sleeping this close to a tick
+    constexpr unsigned long long DEFAULT_SEED = 1; // headless runs use this unless --seed says otherwise
+
+    // frame pacing, see FramePacer
+    constexpr int DEFAULT_TARGET_FPS = 60;        // limit without vsync when the display rate is unknown
+    constexpr int FRAME_SPIN_MARGIN_US = 500;     // spin before a deadline at first, then adapted to measured oversleep
+    constexpr int FRAME_SPIN_MAX_US = 2000;       // the margin never grows past this, even on a badly oversleeping os
+
+    // chunk sizes when a tick is split over the JobSystem, a loop no bigger than one chunk runs inline
+    constexpr int JOB_ASTEROID_GRAIN = 512; // multiple of 8 so every chunk but the last is whole simd registers
+    constexpr int JOB_BULLET_GRAIN = 64;
+
     // UI positioning
     constexpr int ROUND_TEXT_X_OFFSET = 20;
     constexpr int ROUND_TEXT_Y_OFFSET = 20;
@@ -0,0 +1,31 @@
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+struct TextureAsset;
+
+// one sprite as of the last two ticks, top left corners. rendering blends
+// prev -> current so motion stays smooth between ticks
+struct SpriteState {
+    const TextureAsset* texture; // owned by the AssetManager cache, outlives any snapshot
+    float prevX, prevY;
+    float x, y;
+    float w, h;
+    float angle;
+};
+
+// everything the renderer needs from one simulation tick. the simulation
+// thread fills one, publishes it and never touches it again until the
+// renderer has moved on (see TripleBuffer), so drawing needs no locks
+struct GameSnapshot {
+    std::vector<SpriteState> sprites; // in draw order, asteroids, bullets, then the player
+    int round = 1;
+    bool showingTransition = false;
+    bool gameOver = false;
+    Uint64 tick = 0;
+    Uint64 tickCounter = 0; // performance counter time the tick stands for, for interpolation
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef HEADLESS_RUNNER_H
+#define HEADLESS_RUNNER_H
+
+#include "LaunchOptions.h"
+
+// runs Game with no window, renderer or audio as fast as the cpu allows,
+// fed by ScriptedInput or a --replay recording. restarts on game over and
+// prints timings and the final state hash at the end
+class HeadlessRunner {
+public:
+    HeadlessRunner(const LaunchOptions& options);
+
+    int run(); // exit code for main
+
+private:
+    LaunchOptions options_;
+};
+
+#endif
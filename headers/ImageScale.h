@@ -0,0 +1,17 @@
+#ifndef IMAGE_SCALE_H
+#define IMAGE_SCALE_H
+
+#include <SDL2/SDL.h>
+
+// shared by the AssetManager (downscaled levels at load time) and
+// tools/AtlasPacker.cpp (downscaled variants packed into the atlas page),
+// so a sprite looks the same whichever way its small copy was made
+class ImageScale {
+public:
+    // half size copy of an rgba32 surface, each pixel averages a 2x2 block.
+    // colour is weighted by alpha so transparent edges dont darken the sprite.
+    // null if the surface couldnt be created
+    static SDL_Surface* half(SDL_Surface* source);
+};
+
+#endif
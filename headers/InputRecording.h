@@ -0,0 +1,64 @@
+#ifndef INPUT_RECORDING_H
+#define INPUT_RECORDING_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "InputState.h"
+
+// everything besides the inputs a replay needs to take the same path
+struct RecordingHeader {
+    uint64_t seed = 0;
+    uint32_t tickRate = 0;
+    uint32_t screenWidth = 0;
+    uint32_t screenHeight = 0;
+};
+
+// writes the input Game applied on every tick to a small binary file.
+// with the seed and tick rate from the header that is all a headless run
+// needs to play the session back bit for bit (see InputPlayback).
+//
+// file layout, little endian:
+//   magic[8] version:u32 seed:u64 tickRate:u32 screenWidth:u32 screenHeight:u32
+//   then one record per tick: flags:u8 [mouseX:i32 mouseY:i32] [shots:u8]
+// flags holds WASD in the low 4 bits, bit 4 means the aim moved and the
+// mouse position follows, bit 5 means shots follow. a tick where only keys
+// are held is a single byte
+class InputRecorder {
+public:
+    InputRecorder() = default;
+    ~InputRecorder();
+
+    bool open(const std::string& path, const RecordingHeader& header);
+    void record(const InputState& input);
+    void close();
+
+    bool isOpen() const { return out_.is_open(); }
+    uint64_t getTickCount() const { return ticks_; }
+
+private:
+    std::ofstream out_;
+    std::string path_;
+    InputState last_;
+    uint64_t ticks_ = 0;
+};
+
+// reads a recording back, whole file at once since they are tiny
+class InputPlayback {
+public:
+    bool open(const std::string& path);
+
+    // input for the next tick, false once the recording runs out
+    bool next(InputState& input);
+
+    const RecordingHeader& getHeader() const { return header_; }
+
+private:
+    std::vector<unsigned char> data_;
+    size_t cursor_ = 0;
+    RecordingHeader header_;
+    InputState last_;
+};
+
+#endif
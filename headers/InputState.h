@@ -0,0 +1,21 @@
+#ifndef INPUT_STATE_H
+#define INPUT_STATE_H
+
+// everything the player can do in one simulation tick.
+// Game builds this from SDL events, headless runs fill it in from a script
+struct InputState {
+    // WASD held down
+    bool up = false;
+    bool down = false;
+    bool left = false;
+    bool right = false;
+
+    // where the player aims, in screen coordinates
+    int mouseX = 0;
+    int mouseY = 0;
+
+    // left clicks since the last tick, each one fires a bullet
+    int shots = 0;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// work stealing pool for splitting one hot loop over several cores.
+// parallelFor cuts the range into chunks and deals them out in runs to one
+// deque per thread, the calling thread works too and owns deque 0. everyone
+// pops from the back of their own deque and steals from the front of the
+// others once it runs dry, so a thread that got the expensive chunks gets
+// helped instead of waited on. one caller at a time, and the chunks of one
+// loop run at the same time so fn must only write inside its own range
+class JobSystem {
+public:
+    // threads on top of the calling one, 0 runs every loop inline.
+    // negative picks one less than the core count
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // calls fn(begin, end) on consecutive ranges of about grain items that
+    // cover [0, count), returns once all of them are done. a loop that fits
+    // in one grain runs inline, waking workers costs more than it saves
+    template <typename Fn>
+    void parallelFor(size_t count, size_t grain, Fn&& fn) {
+        if (count == 0) return;
+        if (workers_.empty() || count <= grain) {
+            fn(size_t(0), count);
+            return;
+        }
+        using Body = std::remove_reference_t<Fn>;
+        run(count, grain, [](void* context, size_t begin, size_t end) {
+            (*static_cast<Body*>(context))(begin, end);
+        }, const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+    int getThreadCount() const { return static_cast<int>(workers_.size()) + 1; }
+    Uint64 getStealCount() const { return steals_.load(std::memory_order_relaxed); }
+
+private:
+    using ChunkFn = void (*)(void* context, size_t begin, size_t end);
+    static constexpr size_t MAX_CHUNKS_PER_THREAD = 64; // grain grows past this so dealing never allocates
+
+    // chunk indices [head, tail) are still up for grabs
+    struct Deque {
+        std::mutex mutex;
+        std::vector<size_t> chunks;
+        size_t head = 0;
+        size_t tail = 0;
+    };
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<Deque>> deques_; // [0] is the caller's, then one per worker
+
+    // the loop being run. written before any of its chunks are dealt, and a
+    // chunk is only ever taken under its deque's lock, so workers see these
+    ChunkFn fn_;
+    void* context_;
+    size_t count_;
+    size_t grain_;
+    std::atomic<size_t> remaining_; // chunks not finished yet
+    std::atomic<Uint64> steals_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    Uint64 generation_; // bumped per loop so sleeping workers know there is work
+    bool stopping_;
+
+    void run(size_t count, size_t grain, ChunkFn fn, void* context);
+    void workerLoop(size_t self);
+    void runChunks(size_t self);
+    bool pop(size_t self, size_t& chunk);
+    bool steal(size_t self, size_t& chunk);
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef LAUNCH_OPTIONS_H
+#define LAUNCH_OPTIONS_H
+
+#include <cstdint>
+#include <string>
+#include "GameConstants.h"
+
+// command line switches, see printUsage() for the list
+struct LaunchOptions {
+    bool headless = false;      // simulate without a window, renderer or audio
+    int headlessTicks = 72000;  // how long a headless run lasts (10 min at 120 ticks/sec)
+    int tickRate = GameConstants::SIMULATION_TICK_RATE; // simulation ticks per second
+    bool lowLatencyAudio = false; // small device buffer and a bigger voice pool
+    int audioBufferSamples = 0;   // overrides the device buffer size, 0 keeps the mode default
+    bool seedSet = false;         // otherwise headless uses DEFAULT_SEED and a window picks one from the clock
+    uint64_t seed = 0;
+    std::string recordPath;       // write the per tick input here, see InputRecorder
+    std::string replayPath;       // play a recording back headless instead of the script
+    bool profile = false;         // frame profiler on from the start, F3 turns it on later too
+    bool trace = false;           // record a timeline from the start, F4 turns it on later too
+    bool vsync = true;            // present waits for the display, the limiter takes over if the driver cant
+    int targetFps = 0;            // frame limit, 0 leaves it to vsync or the display refresh rate
+    int threads = 0;              // for the simulation's JobSystem, caller included. 0 picks the core count
+
+    // false on a bad argument or --help, the caller should exit
+    static bool parse(int argc, char* argv[], LaunchOptions& options);
+    static void printUsage(const char* program);
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef LOADING_SCREEN_H
+#define LOADING_SCREEN_H
+
+#include <SDL2/SDL.h>
+
+// progress bar shown while AssetLoader works, plain rects so it needs no assets itself
+class LoadingScreen {
+public:
+    LoadingScreen(SDL_Renderer* renderer, int screenWidth, int screenHeight);
+
+    // progress 0..1
+    void render(float progress);
+
+private:
+    SDL_Renderer* renderer_;
+    SDL_Rect frameRect_;
+};
+
+#endif
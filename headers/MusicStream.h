@@ -0,0 +1,83 @@
+#ifndef MUSIC_STREAM_H
+#define MUSIC_STREAM_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct MusicStreamStats {
+    Uint64 underruns;        // audio callbacks that found the ring short and played silence
+    Uint64 segmentsDecoded;
+    size_t bufferBytes;      // ring size, the decoded audio memory ceiling
+    size_t bufferedBytes;    // currently decoded and waiting
+};
+
+// looping mp3 music decoded a bit at a time on its own thread. SDL_mixer has
+// no way to pull pcm out of a Mix_Music, so the file is cut into short runs of
+// mp3 frames and each run is decoded with Mix_LoadWAV_RW, which also converts
+// it to the device format. a couple of frames before each run are decoded too
+// and thrown away, that primes the decoder (bit reservoir, overlap) so the
+// seams are clean. decoded pcm goes through a single producer / single consumer
+// ring to the Mix_HookMusic callback, so memory is the ring plus one run
+class MusicStream {
+public:
+    MusicStream();
+    ~MusicStream();
+
+    MusicStream(const MusicStream&) = delete;
+    MusicStream& operator=(const MusicStream&) = delete;
+
+    // false if path isnt an mp3 this can split, the caller falls back to Mix_LoadMUS then
+    bool open(const std::string& path, int bufferMs);
+
+    // decodes the first run on the calling thread (the one that opened the
+    // mixer), then starts the decoder thread and hooks into the mixer right away
+    void play();
+    // unhooks from the mixer and joins the decoder thread
+    void stop();
+
+    MusicStreamStats getStats() const;
+
+private:
+    SDL_RWops* source_;
+    Sint64 audioStart_;      // file offset of the first real audio frame
+    int sampleRate_;         // of the mp3
+    int samplesPerFrame_;
+
+    int deviceFrequency_;
+    int deviceFrameBytes_;
+
+    // ring, capacity is a power of two, indices only ever grow
+    std::vector<Uint8> ring_;
+    size_t ringMask_;
+    std::atomic<size_t> writeIndex_;
+    std::atomic<size_t> readIndex_;
+
+    std::atomic<bool> running_;
+    std::atomic<bool> hooked_;
+    std::atomic<Uint64> underruns_;
+    std::atomic<Uint64> segmentsDecoded_;
+    std::thread decoder_;
+
+    // mp3 frames waiting to be decoded: pre-roll frames from the previous run + the new run
+    std::vector<Uint8> segment_;
+    std::vector<size_t> frameSizes_;
+
+    struct FrameInfo {
+        int length;
+        int sampleRate;
+        int samplesPerFrame;
+    };
+    static bool parseFrameHeader(const Uint8* header, FrameInfo& info);
+
+    bool readFrame(std::vector<Uint8>& out, FrameInfo& info);
+    Mix_Chunk* decodeSegment(size_t& skipBytes);
+    void decodeLoop(Mix_Chunk* chunk, size_t offset); // carries on with a run play() couldnt fit in the ring
+    size_t write(const Uint8* data, size_t length);
+    static void mixCallback(void* userData, Uint8* stream, int length);
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef PIXEL_CACHE_H
+#define PIXEL_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+// decoded rgba32 pixels on disk, so a png only goes through SDL_image the
+// first time it is loaded. entries are keyed by source path, size and last
+// write time; a changed source (or a different mip setting) is a miss and the
+// caller decodes and stores it again. safe to use from the loader threads,
+// every source path has its own cache file
+class PixelCache {
+public:
+    // fills levels with rgba32 surfaces (the caller frees them), false on a miss
+    static bool load(const std::string& sourcePath, std::vector<SDL_Surface*>& levels);
+
+    // rgba32 surfaces only, written to a temp file and renamed so a crash never leaves half an entry
+    static void store(const std::string& sourcePath, const std::vector<SDL_Surface*>& levels);
+
+private:
+    static std::string entryPath(const std::string& sourcePath);
+};
+
+#endif
@@ -2,33 +2,34 @@
 #define PLAYER_H
 
 #include <SDL2/SDL.h>
-#include <string>
-#include <vector>
-
-class Bullet;
-class Sounds;
+#include "AssetManager.h"
+#include "EntityPool.h"
+#include "Bullet.h"
+#include "InputState.h"
+#include "GameSnapshot.h"
 
 class Player {
 public:
-    Player(SDL_Renderer* renderer, const std::string& path, int screenWidth, int screenHeight, float scale, Sounds* sounds = nullptr);
-    ~Player();
+    Player(SDL_Renderer* renderer, AssetManager* assets, int screenWidth, int screenHeight, float scale);
     // these are set on the constructor in the cpp file
-    void handleEvent(const SDL_Event& e); // Keyboard input (WASD)
-    void render();                       
+    void applyInput(const InputState& input); // WASD + aim for this tick
+    bool getSprite(SpriteState& sprite) const; // how to draw it this tick, false if there is nothing to draw
     void update(float deltaTime);      
+    void reset(); // back to the middle of the screen, standing still
 
     SDL_Rect getHitbox() const;
 
     float getX() const { return x_; }     // used for pathfinding
     float getY() const { return y_; }
 
-    void shoot(std::vector<Bullet*>& bullets); // fire a bullet, puts a new bullet into the bullets vector
+    bool shoot(EntityPool<Bullet>& bullets); // fire a bullet toward the aim point, false if the pool was full
 
 private:
     SDL_Renderer* renderer_;
-    SDL_Texture* texture_;
-    Sounds* sounds_ = nullptr;
+    TextureHandle texture_;
+    TextureHandle bulletTexture_; // looked up once, handed to every bullet we fire
     float x_, y_;         // Position
+    float prevX_, prevY_; // Position before the last update, for interpolation
     int w_, h_;           // Sprite size
     float speed_;         // Movement speed
     float scale_;         // How big/small u want the sprite to be cuh
@@ -41,6 +42,10 @@ private:
     bool movingLeft_;
     bool movingRight_;
 
+    // aim point from the last applied input
+    int aimX_;
+    int aimY_;
+
     float getAngleToMouse() const; // Helper function to rotate towards the mouse
 
 };
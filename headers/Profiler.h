@@ -0,0 +1,98 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "Trace.h"
+
+// the parts of a frame that get timed. a fixed list instead of names so
+// adding time to a scope is an array index, not a lookup
+enum class ProfileScope {
+    Frame,       // beginFrame() to endFrame(), everything below is inside it
+    Events,
+    Update,      // Game::update ticks that ended during the frame, on the simulation thread, the next four are inside it
+    Spawn,
+    Bullets,
+    Asteroids,
+    Collisions,
+    Background,
+    Render,      // Game::render
+    Present,
+    Idle,        // FramePacer sleeping/spinning until the next frame is due
+    Count
+};
+
+struct ProfileStats {
+    float lastMs;
+    float p50Ms;
+    float p99Ms;
+};
+
+// per frame time of each scope, kept for the last HISTORY_FRAMES frames.
+// frames are the main thread's, scopes can be timed from any thread and land in
+// whatever frame is open when they end. while this and Trace are disabled a
+// ScopedTimer costs two branches
+class Profiler {
+public:
+    static constexpr int HISTORY_FRAMES = 1024; // ~17 s at 60 fps
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // frame boundaries, time added in between counts toward this frame.
+    // a scope hit several times in a frame (one per tick) is summed
+    static void beginFrame();
+    static void endFrame();
+
+    static void add(ProfileScope scope, Uint64 counterTicks) {
+        frameTicks_[static_cast<int>(scope)].fetch_add(counterTicks, std::memory_order_relaxed);
+    }
+
+    // over the frames in the history, the copy is sorted so dont call this per scope per frame
+    static ProfileStats getStats(ProfileScope scope);
+    static int getFrameCount() { return frameCount_ < HISTORY_FRAMES ? frameCount_ : HISTORY_FRAMES; }
+    static const char* getName(ProfileScope scope);
+
+    // one row per frame in the history, oldest first, times in ms
+    static bool writeCsv(const std::string& path);
+
+private:
+    static constexpr int SCOPE_COUNT = static_cast<int>(ProfileScope::Count);
+
+    static std::atomic<bool> enabled_;
+    static Uint64 frameStart_;
+    static std::atomic<Uint64> frameTicks_[SCOPE_COUNT];
+    static std::vector<float> history_; // HISTORY_FRAMES rows of SCOPE_COUNT ms values
+    static int frameCount_;             // frames recorded so far, the ring wraps on it
+    static std::vector<float> sortScratch_;
+};
+
+// times the enclosing block into one scope, and puts it on the trace timeline when that is on
+class ScopedTimer {
+public:
+    explicit ScopedTimer(ProfileScope scope)
+        : scope_(scope), start_(Profiler::isEnabled() ? SDL_GetPerformanceCounter() : 0),
+          traced_(Trace::isEnabled()) {
+        if (traced_) Trace::begin(Profiler::getName(scope_));
+    }
+    ~ScopedTimer() {
+        if (start_) Profiler::add(scope_, SDL_GetPerformanceCounter() - start_);
+        if (traced_) Trace::end(Profiler::getName(scope_));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    ProfileScope scope_;
+    Uint64 start_;
+    bool traced_;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(scope) ScopedTimer PROFILE_CONCAT(profileTimer_, __LINE__)(ProfileScope::scope)
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef PROFILER_OVERLAY_H
+#define PROFILER_OVERLAY_H
+
+#include <SDL2/SDL.h>
+#include <memory>
+#include <string>
+#include "Profiler.h"
+
+class UIRenderer;
+
+// last / p50 / p99 ms of every profiler scope in the corner of the screen.
+// the font is only loaded the first time it is shown
+class ProfilerOverlay {
+public:
+    ProfilerOverlay(SDL_Renderer* renderer, int screenWidth);
+    ~ProfilerOverlay();
+
+    // showing it turns the profiler on, hiding leaves it running so the csv stays complete
+    void toggle();
+    bool isVisible() const { return visible_; }
+
+    void render();
+
+private:
+    static constexpr int SCOPE_COUNT = static_cast<int>(ProfileScope::Count);
+    static constexpr int REFRESH_FRAMES = 15; // stats are re-sorted this often, not every frame
+
+    SDL_Renderer* renderer_;
+    std::unique_ptr<UIRenderer> ui_;
+    int screenWidth_;
+    bool visible_;
+    int framesUntilRefresh_;
+    std::string lines_[SCOPE_COUNT + 1]; // header + one per scope, rebuilt on refresh
+
+    void refresh();
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+// small fast PRNG (pcg32) owned by Game, so the same seed rolls the exact
+// same asteroids on every machine. rand() is global, unseeded and its
+// sequence differs between C libraries, which made runs unreproducible
+class Random {
+public:
+    explicit Random(uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(uint64_t seed) {
+        state_ = 0;
+        nextU32();
+        state_ += seed;
+        nextU32();
+    }
+
+    uint32_t nextU32() {
+        uint64_t old = state_;
+        state_ = old * 6364136223846793005ULL + INCREMENT;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rot = static_cast<uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    // [0, 1), built from the top 24 bits so every value is exact in a float
+    float nextFloat() { return (nextU32() >> 8) * (1.0f / 16777216.0f); }
+
+    // [min, max)
+    float range(float min, float max) { return min + nextFloat() * (max - min); }
+
+    // [0, n), n > 0. multiply-shift instead of % so small n arent biased
+    int below(int n) {
+        return static_cast<int>((static_cast<uint64_t>(nextU32()) * static_cast<uint32_t>(n)) >> 32);
+    }
+
+private:
+    static constexpr uint64_t INCREMENT = 1442695040888963407ULL;
+    uint64_t state_;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef ROUND_MANAGER_H
 #define ROUND_MANAGER_H
 
+#include <cstddef>
 #include <vector>
 
 class Asteroid;
@@ -10,11 +10,13 @@
 class SDLManager {
 public:
 
-    static bool initialize();
+    // headless skips video, SDL_image and SDL_ttf, only timers are needed
+    static bool initialize(bool headless = false);
     static void cleanup();
 
 private:
     static bool initialized_; // yes? no? maybe? hotel? trivago
+    static bool headless_;
 };
 
 #endif 
@@ -0,0 +1,25 @@
+#ifndef SCRIPTED_INPUT_H
+#define SCRIPTED_INPUT_H
+
+#include "InputState.h"
+
+// fake player for headless runs: walks a fixed pattern, sweeps the aim
+// around the screen and fires at a steady rate. same input every run
+class ScriptedInput {
+public:
+    ScriptedInput(int screenWidth, int screenHeight);
+
+    InputState next(); // input for the next tick
+
+private:
+    int screenWidth_;
+    int screenHeight_;
+    int tick_;
+
+    static constexpr int TICKS_PER_MOVE = 90;   // how long each walking direction lasts
+    static constexpr int TICKS_PER_SHOT = 6;
+    static constexpr float AIM_RADIUS = 500.0f;
+    static constexpr float AIM_TURN_PER_TICK = 0.05f; // radians
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef SIMULATION_THREAD_H
+#define SIMULATION_THREAD_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <thread>
+#include "FixedTimestep.h"
+#include "GameSnapshot.h"
+#include "TripleBuffer.h"
+
+class Game;
+
+// runs Game::update at the fixed tick rate on its own thread, so a slow
+// present on the main thread no longer holds the simulation back (and the
+// other way round). after each batch of ticks the game state is copied into
+// a snapshot and published, the main thread draws the newest one it can get.
+// SDL rendering stays on the main thread, this thread never touches the renderer
+class SimulationThread {
+public:
+    SimulationThread(Game& game, int tickRate, int maxStepsPerFrame);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // call after game.initialize(), ticks start counting from here
+    void start();
+    // joins the thread, the game can be read from the main thread again after this
+    void stop();
+
+    // set once an update ends the game, the thread has stopped ticking by then
+    bool isFinished() const { return finished_.load(std::memory_order_acquire); }
+
+    // main thread: the newest published snapshot, stays valid until the next call
+    const GameSnapshot& acquireSnapshot();
+    // 0..1, how far the present moment is past the snapshot's tick, for interpolation
+    float getAlpha(const GameSnapshot& snapshot) const;
+
+    Uint64 getTickCount() const { return ticks_.load(std::memory_order_relaxed); }
+
+private:
+    Game& game_;
+    FixedTimestep timestep_;
+    TripleBuffer<GameSnapshot> snapshots_;
+    double counterToSeconds_;
+
+    std::atomic<bool> running_;
+    std::atomic<bool> finished_;
+    std::atomic<Uint64> ticks_;
+    std::thread thread_;
+
+    void run();
+};
+
+#endif
@@ -1,20 +1,77 @@
 #pragma once
 #include <SDL2/SDL_mixer.h>
+#include <atomic>
+#include <memory>
 #include <string>
+#include <vector>
+#include "MusicStream.h"
+#include "AudioEvents.h"
+
+// how the audio device is opened. the defaults match the original 2048 sample
+// buffer, lowLatency() trades a little cpu for a much shorter trigger-to-speaker path
+struct AudioConfig {
+    int bufferSamples = 2048; // device buffer per callback, sound can't start sooner than this
+    int voices = 8;           // mixer channels shared by the sound effects
+
+    static AudioConfig lowLatency();
+};
+
+// trigger-to-output latency of sound effects. measured from playEvents() to
+// the mixer first touching the chunk, plus one device buffer for it to reach the speaker
+struct AudioLatencyStats {
+    Uint64 samples;
+    double averageMs;
+    double worstMs;
+    double bufferMs;        // the device buffer part of the above
+    double trimmedMs;       // leading silence cut off the gun sound at load
+    Uint64 stolenVoices;    // effects that cut off the oldest playing one
+};
 
 class Sounds {
 public:
     Sounds() = default;
     ~Sounds();
 
-    bool init();
+    bool init(const AudioConfig& config = AudioConfig());
     bool loadMusic(const std::string& path);
     bool loadGunSound(const std::string& path);
 
     void playMusic();
-    void playGunSound();
+    // one voice per queued event, panned and attenuated around the listener.
+    // called once per frame with everything Game queued during its ticks
+    void playEvents(const AudioEventQueue& events, int screenWidth, int screenHeight);
+
+    AudioLatencyStats getLatencyStats() const;
+    bool isMusicStreaming() const { return musicStream != nullptr; }
+    MusicStreamStats getMusicStats() const;
 
 private:
-    Mix_Music* bgMusic = nullptr;
+    Mix_Music* bgMusic = nullptr;          // only when the music couldnt be streamed
+    std::unique_ptr<MusicStream> musicStream;
     Mix_Chunk* gunSound = nullptr;
+    // there are no impact/death recordings, these are made at init as filtered
+    // noise. QuickLoad chunks dont own their samples, the vectors do
+    Mix_Chunk* impactSound = nullptr;
+    Mix_Chunk* deathSound = nullptr;
+    std::vector<Uint8> impactSamples;
+    std::vector<Uint8> deathSamples;
+
+    AudioConfig config;
+    int deviceFrequency = 0;
+    Uint16 deviceFormat = 0;
+    int deviceChannels = 0;
+    double trimmedMs = 0.0;
+
+    // per voice counter value of the pending trigger, 0 once it has been mixed
+    std::unique_ptr<std::atomic<Uint64>[]> triggerCounters;
+    std::atomic<Uint64> latencySamples{0};
+    std::atomic<Uint64> latencyTotal{0};
+    std::atomic<Uint64> latencyWorst{0};
+    Uint64 stolenVoices = 0;
+
+    void trimLeadingSilence(Mix_Chunk* chunk);
+    Mix_Chunk* makeNoiseBurst(std::vector<Uint8>& samples, int lengthMs, float decayMs, float smoothing);
+    Mix_Chunk* chunkFor(SoundEffect effect) const;
+    int playEffect(Mix_Chunk* chunk, int volume, Sint16 angle, Uint8 distance);
+    static void measureEffect(int channel, void* stream, int length, void* userData);
 };
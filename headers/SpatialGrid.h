@@ -0,0 +1,52 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+class AsteroidField;
+
+// uniform grid over the playfield used as collision broadphase.
+// every asteroid is listed in each cell its hitbox touches, anything outside
+// the playfield is clamped into the border cells so nothing gets lost.
+// cells are stored back to back (counting sort) and rebuilt every tick
+class SpatialGrid {
+public:
+    SpatialGrid(int width, int height, int cellSize);
+
+    void rebuild(const AsteroidField& asteroids);
+
+    // calls fn(index) for every asteroid sharing a cell with rect.
+    // an index can come up more than once if both span several cells,
+    // within one cell indices come in ascending order
+    template <typename Fn>
+    void forEachCandidate(const SDL_Rect& rect, Fn&& fn) const {
+        int x0, y0, x1, y1;
+        if (!cellRange(rect, x0, y0, x1, y1)) return;
+
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                int cell = cy * cols_ + cx;
+                for (int i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+                    fn(static_cast<size_t>(entries_[i]));
+                }
+            }
+        }
+    }
+
+    int getCellCount() const { return cols_ * rows_; }
+    size_t getEntryCount() const { return entries_.size(); }
+
+private:
+    int cellSize_;
+    int cols_, rows_;
+
+    std::vector<int> cellStart_;   // cell c owns entries_[cellStart_[c] .. cellStart_[c + 1])
+    std::vector<int> cellCursor_;  // fill position per cell while rebuilding
+    std::vector<int> entries_;     // asteroid indices grouped by cell
+
+    // false for empty rects, those can never intersect anything
+    bool cellRange(const SDL_Rect& rect, int& x0, int& y0, int& x1, int& y1) const;
+};
+
+#endif
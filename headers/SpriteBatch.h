@@ -0,0 +1,46 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "AssetManager.h"
+
+// collects rotated sprites for a frame and draws each run of consecutive
+// sprites that share a texture with one SDL_RenderGeometry call, instead of
+// one RenderCopyEx each. sprites come out in exactly the order they were
+// drawn, a texture change just starts the next run. so the fewer switches
+// the caller makes (an atlas makes none) the fewer calls it takes
+class SpriteBatch {
+public:
+    SpriteBatch(SDL_Renderer* renderer);
+
+    void begin();
+
+    // same placement as SDL_RenderCopyEx with a null center:
+    // dst in screen space, rotated clockwise by angle degrees around its middle.
+    // only texture.source is drawn, so atlas regions work like plain textures
+    void draw(const TextureAsset& texture, const SDL_FRect& dst, float angle);
+
+    // submits every run in order, call before drawing anything that has to go on top
+    void flush();
+
+    int getDrawCalls() const { return drawCalls_; }   // SDL_RenderGeometry calls in the last flush
+    int getSpriteCount() const { return spriteCount_; }
+
+private:
+    struct Run {
+        SDL_Texture* texture;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    SDL_Renderer* renderer_;
+    std::vector<Run> runs_; // kept with their buffers between frames, only the first runCount_ are this frame's
+    size_t runCount_;
+    int drawCalls_;
+    int spriteCount_;
+
+    Run& runFor(SDL_Texture* texture);
+};
+
+#endif
@@ -3,12 +3,13 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
-#include <SDL2/SDL_image.h>
 #include <string>
+#include "AssetManager.h"
 
 class StartScreen {
 public:
-    StartScreen(SDL_Renderer* renderer, int screenWidth, int screenHeight);
+    // player sprite comes from assets, the same decoded texture the game uses
+    StartScreen(SDL_Renderer* renderer, AssetManager* assets, int screenWidth, int screenHeight);
     ~StartScreen();
     
     void handleEvent(const SDL_Event& e);
@@ -19,7 +20,7 @@ public:
 private:
     SDL_Renderer* renderer_;
     SDL_Texture* playButtonTexture_;
-    SDL_Texture* playerTexture_;
+    TextureHandle playerTexture_;
     SDL_Rect playButtonRect_;
     SDL_Rect playerRect_;
     TTF_Font* font_;
@@ -32,7 +33,7 @@ private:
     bool startGame_;
     
     void createPlayButton();
-    void loadPlayerTexture();
+    void loadPlayerTexture(AssetManager* assets);
     float getAngleToMouse() const;
     bool isMouseOverButton(int mouseX, int mouseY) const;
 };
@@ -0,0 +1,60 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <string>
+
+// timeline of begin/end events from every thread, written out as Chrome
+// trace event json (open in chrome://tracing or ui.perfetto.dev).
+// each thread appends to its own buffer with no locks and no allocation,
+// so the audio callback can record too. buffers grow from a pool of chunks
+// the main thread tops up in refill(). event names are stored as pointers,
+// so they have to be string literals or live as long as the trace
+class Trace {
+public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // main thread only, once a frame. replaces the chunks other threads took
+    // from the pool, a thread that finds it empty drops scopes until the next refill
+    static void refill();
+
+    static void begin(const char* name);
+    static void end(const char* name);
+    // label for the calling thread's row in the viewer, cheap enough to call
+    // at the top of a callback that runs on a thread we dont own
+    static void setThreadName(const char* name);
+
+    // everything recorded so far, recording carries on afterwards
+    static bool write(const std::string& path);
+    static size_t getEventCount();
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+// begin/end pair around the enclosing block. if tracing was off when the
+// block started no end is written either, so pairs never come out unbalanced
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : name_(Trace::isEnabled() ? name : nullptr) {
+        if (name_) Trace::begin(name_);
+    }
+    ~TraceScope() {
+        if (name_) Trace::end(name_);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+#endif
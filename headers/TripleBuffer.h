@@ -0,0 +1,40 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+// one writer thread, one reader thread, no locks and neither side ever waits.
+// the writer fills back() and publishes it, the reader picks up the newest
+// published value with acquire(). with three slots the writer always has one
+// the reader isnt looking at, so a slow reader just skips values
+template <typename T>
+class TripleBuffer {
+public:
+    // writer only
+    T& back() { return slots_[back_]; }
+    void publish() {
+        back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // reader only. true if front() changed since the last call
+    bool acquire() {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH)) return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T& front() const { return slots_[front_]; }
+
+    // before any thread starts, e.g. to reserve memory in every slot
+    T& slot(int index) { return slots_[index]; }
+
+private:
+    static constexpr int INDEX = 3;
+    static constexpr int FRESH = 4; // middle holds a value the reader hasnt taken yet
+
+    T slots_[3];
+    int back_ = 0;
+    std::atomic<int> middle_{1};
+    int front_ = 2;
+};
+
+#endif
@@ -3,32 +3,114 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <list>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+struct TextCacheStats {
+    size_t entries;
+    size_t bytes;          // estimated texture memory held (w * h * 4)
+    size_t capacityBytes;
+    Uint64 hits;
+    Uint64 misses;
+    Uint64 evictions;
+};
 
 class UIRenderer {
 public:
 
     UIRenderer(SDL_Renderer* renderer, const std::string& fontPath, 
                int normalFontSize, int largeFontSize);
+
+    // one font for everything, large draws come out at the same size
+    UIRenderer(SDL_Renderer* renderer, const std::string& fontPath, int fontSize)
+        : UIRenderer(renderer, fontPath, fontSize, fontSize) {}
     
     ~UIRenderer();
 
+    // for strings that stay the same for a while: rendered to a texture once,
+    // then every frame after that is a single SDL_RenderCopy out of the cache
     void renderText(const std::string& text, int x, int y, 
                     int fontSize, const SDL_Color& color);
 
     void renderTextCentered(const std::string& text, int centerX, int centerY,
                            int fontSize, const SDL_Color& color);
 
+    // for strings that change every frame (timers, counters): drawn straight
+    // from the glyph atlas so they dont churn the cache
+    void renderTextDynamic(const std::string& text, int x, int y,
+                           int fontSize, const SDL_Color& color);
+
+    // size the text would take on screen, from cached glyph metrics
+    void measureText(const std::string& text, int fontSize, int& width, int& height) const;
+
     bool isInitialized() const { return initialized_; }
 
+    TextCacheStats getTextCacheStats() const;
+
 private:
+    // printable ascii, anything else is skipped when drawing
+    static constexpr int FIRST_GLYPH = 32;
+    static constexpr int LAST_GLYPH = 126;
+    static constexpr int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+    static constexpr int ATLAS_WIDTH = 1024;
+
+    // text cache bounds, least recently used strings go first
+    static constexpr size_t TEXT_CACHE_MAX_BYTES = 4 * 1024 * 1024;
+    static constexpr size_t TEXT_CACHE_MAX_ENTRIES = 64;
+
+    struct Glyph {
+        SDL_Rect src;   // where the glyph sits in the atlas texture, w == 0 if it failed to render
+        int advance;    // how far the pen moves after drawing it
+    };
+
+    // every glyph of one font rasterized once into a single texture
+    struct GlyphAtlas {
+        SDL_Texture* texture = nullptr;
+        int width = 0, height = 0;  // texture size, for uv coordinates
+        Glyph glyphs[GLYPH_COUNT];
+        std::vector<int> kerning; // GLYPH_COUNT * GLYPH_COUNT, [previous * GLYPH_COUNT + current]
+        int lineHeight = 0;
+    };
+
+    // one rendered string
+    struct CachedText {
+        std::string key;
+        SDL_Texture* texture;
+        int width, height;
+        size_t bytes;
+    };
+
     SDL_Renderer* renderer_;
     TTF_Font* normalFont_;
-    TTF_Font* largeFont_;
+    TTF_Font* largeFont_;           // nullptr when both sizes match, the normal font covers both
+    GlyphAtlas normalAtlas_;
+    GlyphAtlas largeAtlas_;
     bool initialized_;
-    
-    void renderTextWithFont(const std::string& text, int x, int y,
-                           TTF_Font* font, const SDL_Color& color);
+
+    // reused every draw so text doesnt allocate per frame
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+
+    std::list<CachedText> textCache_; // most recently used at the front
+    std::unordered_map<std::string, std::list<CachedText>::iterator> textCacheIndex_;
+    std::string lookupKey_;           // reused so a cache hit doesnt allocate
+    size_t textCacheBytes_;
+    Uint64 textCacheHits_;
+    Uint64 textCacheMisses_;
+    Uint64 textCacheEvictions_;
+
+    // nullptr if the text cant be rendered or is too big to keep
+    const CachedText* getCachedText(const std::string& text, int fontSize, const SDL_Color& color);
+    void evictText(size_t incomingBytes);
+    void clearTextCache();
+
+    bool buildAtlas(TTF_Font* font, GlyphAtlas& atlas);
+    bool usesLargeFont(int fontSize) const { return fontSize != 0 && largeFont_; }
+    const GlyphAtlas& atlasFor(int fontSize) const;
+    void drawText(const GlyphAtlas& atlas, const std::string& text, int x, int y,
+                  const SDL_Color& color);
 };
 
-#endif 
+#endif
@@ -1,34 +1,149 @@
 #include "../headers/AnimatedBackground.h"
+#include "../headers/AssetIO.h"
+#include "../headers/PixelCache.h"
 #include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 
-AnimatedBackground::AnimatedBackground(SDL_Renderer* renderer, const std::string& folder, int frameCount, int frameDelayMs)
-    : renderer_(renderer), currentFrame_(0), frameCount_(frameCount), frameDelayMs_(frameDelayMs)
+AnimatedBackground::AnimatedBackground(SDL_Renderer* renderer, std::vector<SDL_Surface*> frames, int frameDelayMs)
+    : renderer_(renderer), currentFrame_(0), frameCount_(0), frameDelayMs_(frameDelayMs),
+      frameW_(0), frameH_(0),
+      sheet_(nullptr), sheetW_(0), sheetH_(0),
+      streamTexture_(nullptr), uploadedFrame_(-1)
 {
     lastUpdate_ = std::chrono::steady_clock::now();
+    build(frames);
+}
+
+SDL_Surface* AnimatedBackground::decodeFrame(const std::string& folder, int index) {
+    std::stringstream path;
+    path << folder << "/frame" << index << ".png";
+
+    // only touches surfaces, no renderer calls, so any thread can run this
+    std::vector<SDL_Surface*> cached;
+    if (PixelCache::load(path.str(), cached)) {
+        for (size_t i = 1; i < cached.size(); ++i) {
+            SDL_FreeSurface(cached[i]);
+        }
+        return cached[0];
+    }
+
+    SDL_Surface* loaded = IMG_Load_RW(AssetIO::open(path.str()), 1);
+    if (!loaded) {
+        std::cerr << "Failed to load " << path.str() << ": " << IMG_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_Surface* frame = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    if (frame) {
+        PixelCache::store(path.str(), std::vector<SDL_Surface*>{frame});
+    }
+    return frame;
+}
 
-    for (int i = 1; i <= frameCount_; ++i) {
-        std::stringstream path;
-        path << folder << "/frame" << i << ".png";
-        SDL_Surface* surface = IMG_Load(path.str().c_str());
-        if (!surface) {
-            std::cerr << "Failed to load " << path.str() << ": " << IMG_GetError() << std::endl;
+void AnimatedBackground::build(std::vector<SDL_Surface*>& decoded) {
+    // keep the frames that loaded, all must match the first ones size to share a texture
+    std::vector<SDL_Surface*> frames;
+    for (SDL_Surface* frame : decoded) {
+        if (!frame) continue;
+        if (!frames.empty() && (frame->w != frames[0]->w || frame->h != frames[0]->h)) {
+            std::cerr << "Background frame size mismatch, skipping frame" << std::endl;
+            SDL_FreeSurface(frame);
             continue;
         }
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer_, surface);
-        SDL_FreeSurface(surface);
-        frames_.push_back(tex);
+        frames.push_back(frame);
+    }
+    decoded.clear();
+    if (frames.empty()) return;
+
+    frameW_ = frames[0]->w;
+    frameH_ = frames[0]->h;
+    frameCount_ = static_cast<int>(frames.size());
+
+    if (buildSheet(frames)) {
+        for (SDL_Surface* frame : frames) {
+            SDL_FreeSurface(frame);
+        }
+    } else if (!buildStream(frames)) {
+        for (SDL_Surface* frame : frames) {
+            SDL_FreeSurface(frame);
+        }
+        frameCount_ = 0;
     }
 }
 
 AnimatedBackground::~AnimatedBackground() {
-    for (auto tex : frames_) {
-        SDL_DestroyTexture(tex);
+    if (sheet_) SDL_DestroyTexture(sheet_);
+    if (streamTexture_) SDL_DestroyTexture(streamTexture_);
+    for (SDL_Surface* frame : decoded_) {
+        SDL_FreeSurface(frame);
     }
 }
 
+bool AnimatedBackground::buildSheet(const std::vector<SDL_Surface*>& frames) {
+    SDL_RendererInfo info;
+    int maxW = 0, maxH = 0;
+    if (SDL_GetRendererInfo(renderer_, &info) == 0) {
+        maxW = info.max_texture_width;
+        maxH = info.max_texture_height;
+    }
+
+    // grid with the smallest longest side that the gpu still accepts (0 means no limit)
+    int count = static_cast<int>(frames.size());
+    int columns = 0;
+    for (int c = 1; c <= count; ++c) {
+        int w = c * frameW_;
+        int h = (count + c - 1) / c * frameH_;
+        if ((maxW && w > maxW) || (maxH && h > maxH)) continue;
+        if (columns == 0 || std::max(w, h) < std::max(sheetW_, sheetH_)) {
+            columns = c;
+            sheetW_ = w;
+            sheetH_ = h;
+        }
+    }
+    if (columns == 0) return false;
+
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, sheetW_, sheetH_, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!sheet) return false;
+
+    // same pixel format everywhere, so copying rows is all a blit would do
+    for (int i = 0; i < count; ++i) {
+        SDL_Rect rect{(i % columns) * frameW_, (i / columns) * frameH_, frameW_, frameH_};
+        const Uint8* src = static_cast<const Uint8*>(frames[i]->pixels);
+        Uint8* dst = static_cast<Uint8*>(sheet->pixels) + rect.y * sheet->pitch + rect.x * 4;
+        for (int row = 0; row < frameH_; ++row) {
+            std::memcpy(dst + row * sheet->pitch, src + row * frames[i]->pitch, frameW_ * 4);
+        }
+        frameRects_.push_back(rect);
+    }
+
+    sheet_ = SDL_CreateTextureFromSurface(renderer_, sheet);
+    SDL_FreeSurface(sheet);
+    if (!sheet_) {
+        frameRects_.clear();
+        sheetW_ = sheetH_ = 0;
+        return false;
+    }
+    return true;
+}
+
+bool AnimatedBackground::buildStream(std::vector<SDL_Surface*>& frames) {
+    streamTexture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32,
+                                       SDL_TEXTUREACCESS_STREAMING, frameW_, frameH_);
+    if (!streamTexture_) {
+        std::cerr << "Failed to create background texture: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(streamTexture_, SDL_BLENDMODE_BLEND);
+    decoded_.swap(frames);
+    return true;
+}
+
 void AnimatedBackground::update() {
+    if (frameCount_ == 0) return;
+
     auto now = std::chrono::steady_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastUpdate_).count();
 
@@ -39,6 +154,27 @@ void AnimatedBackground::update() {
 }
 
 void AnimatedBackground::render() {
-    if (frames_.empty()) return;
-    SDL_RenderCopy(renderer_, frames_[currentFrame_], nullptr, nullptr);
+    if (sheet_) {
+        SDL_RenderCopy(renderer_, sheet_, &frameRects_[currentFrame_], nullptr);
+    } else if (streamTexture_) {
+        // only upload when the frame actually changed, not every render
+        if (uploadedFrame_ != currentFrame_) {
+            SDL_Surface* frame = decoded_[currentFrame_];
+            SDL_UpdateTexture(streamTexture_, nullptr, frame->pixels, frame->pitch);
+            uploadedFrame_ = currentFrame_;
+        }
+        SDL_RenderCopy(renderer_, streamTexture_, nullptr, nullptr);
+    }
+}
+
+AnimatedBackground::MemoryUsage AnimatedBackground::getMemoryUsage() const {
+    MemoryUsage usage{0, 0};
+    size_t frameBytes = static_cast<size_t>(frameW_) * frameH_ * 4;
+    if (sheet_) {
+        usage.textureBytes = static_cast<size_t>(sheetW_) * sheetH_ * 4;
+    } else if (streamTexture_) {
+        usage.textureBytes = frameBytes;
+        usage.cpuBytes = frameBytes * decoded_.size();
+    }
+    return usage;
 }
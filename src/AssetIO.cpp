@@ -0,0 +1,164 @@
+#include "../headers/AssetIO.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const unsigned char* AssetIO::data_ = nullptr;
+size_t AssetIO::size_ = 0;
+bool AssetIO::mapped_ = false;
+std::vector<unsigned char> AssetIO::buffer_;
+std::unordered_map<std::string, AssetIO::Entry> AssetIO::index_;
+int64_t AssetIO::archiveModified_ = 0;
+
+namespace {
+
+// little endian no matter what the host is
+template <typename T>
+bool readValue(const unsigned char* data, size_t size, size_t& cursor, T& value) {
+    if (cursor + sizeof(T) > size) return false;
+    value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<T>(data[cursor + i]) << (8 * i);
+    }
+    cursor += sizeof(T);
+    return true;
+}
+
+}
+
+bool AssetIO::mount(const std::string& archivePath) {
+    unmount();
+
+#ifndef _WIN32
+    int fd = ::open(archivePath.c_str(), O_RDONLY);
+    if (fd < 0) return false; // no archive is fine, loose files it is
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map " << archivePath << std::endl;
+        return false;
+    }
+    data_ = static_cast<const unsigned char*>(mapping);
+    size_ = static_cast<size_t>(info.st_size);
+    mapped_ = true;
+#else
+    // no mmap here, one read of the whole archive is the next best thing
+    std::ifstream file(archivePath, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    buffer_.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (buffer_.empty() || !file.read(reinterpret_cast<char*>(buffer_.data()), buffer_.size())) {
+        buffer_.clear();
+        return false;
+    }
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    mapped_ = false;
+#endif
+
+    if (!readIndex()) {
+        std::cerr << archivePath << " is not a valid asset archive, using loose files" << std::endl;
+        unmount();
+        return false;
+    }
+
+    std::error_code error;
+    archiveModified_ = std::filesystem::last_write_time(archivePath, error).time_since_epoch().count();
+    return true;
+}
+
+bool AssetIO::readIndex() {
+    if (size_ < sizeof(MAGIC) || std::memcmp(data_, MAGIC, sizeof(MAGIC)) != 0) return false;
+
+    size_t cursor = sizeof(MAGIC);
+    uint32_t count;
+    if (!readValue(data_, size_, cursor, count)) return false;
+
+    index_.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint16_t pathLength;
+        uint64_t offset, size;
+        if (!readValue(data_, size_, cursor, pathLength) || cursor + pathLength > size_) return false;
+        std::string path(reinterpret_cast<const char*>(data_ + cursor), pathLength);
+        cursor += pathLength;
+        if (!readValue(data_, size_, cursor, offset) || !readValue(data_, size_, cursor, size)) return false;
+        if (offset > size_ || size > size_ - offset) return false;
+
+        index_[path] = Entry{static_cast<size_t>(offset), static_cast<size_t>(size)};
+    }
+    return true;
+}
+
+void AssetIO::unmount() {
+#ifndef _WIN32
+    if (data_ && mapped_) {
+        munmap(const_cast<unsigned char*>(data_), size_);
+    }
+#endif
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    index_.clear();
+    archiveModified_ = 0;
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
+
+SDL_RWops* AssetIO::open(const std::string& path) {
+    if (data_) {
+        auto it = index_.find(path);
+        if (it != index_.end()) {
+            return SDL_RWFromConstMem(data_ + it->second.offset, static_cast<int>(it->second.size));
+        }
+    }
+    return SDL_RWFromFile(path.c_str(), "rb");
+}
+
+bool AssetIO::readFile(const std::string& path, std::string& contents) {
+    if (data_) {
+        auto it = index_.find(path);
+        if (it != index_.end()) {
+            contents.assign(reinterpret_cast<const char*>(data_ + it->second.offset), it->second.size);
+            return true;
+        }
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool AssetIO::getFileInfo(const std::string& path, uint64_t& size, int64_t& modified) {
+    if (data_) {
+        auto it = index_.find(path);
+        if (it != index_.end()) {
+            size = it->second.size;
+            modified = archiveModified_;
+            return true;
+        }
+    }
+
+    std::error_code error;
+    size = std::filesystem::file_size(path, error);
+    if (error) return false;
+    modified = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+    return !error;
+}
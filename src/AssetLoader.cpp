@@ -0,0 +1,124 @@
+#include "../headers/AssetLoader.h"
+#include "../headers/AssetManager.h"
+#include "../headers/Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+AssetLoader::AssetLoader(int threadCount)
+    : finished_(0), failed_(0), stopping_(false) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        workers_.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        queued_.clear(); // anything not started yet is dropped
+    }
+    workReady_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    for (Job* job : jobs_) {
+        delete job;
+    }
+}
+
+void AssetLoader::add(std::function<bool()> work, std::function<void()> finish) {
+    Job* job = new Job{std::move(work), std::move(finish), false};
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(job);
+        queued_.push_back(job);
+    }
+    workReady_.notify_one();
+}
+
+void AssetLoader::addTexture(AssetManager& assets, const std::string& path) {
+    std::string file = assets.getSourceFile(path);
+    if (assets.isCached(file) || !queuedTextures_.insert(file).second) return;
+
+    // shared so the worker and the render thread step can both hold it
+    auto image = std::make_shared<DecodedImage>();
+    bool withLevels = !assets.isAtlasPage(file);
+    add([file, image, withLevels]() { return AssetManager::decodeImage(file, *image, withLevels); },
+        [&assets, file, image]() { assets.addDecoded(file, *image); });
+}
+
+void AssetLoader::workerLoop() {
+    Trace::setThreadName("asset loader");
+    for (;;) {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            workReady_.wait(lock, [this]() { return stopping_ || !queued_.empty(); });
+            if (stopping_) return;
+            job = queued_.front();
+            queued_.pop_front();
+        }
+
+        bool succeeded;
+        {
+            TRACE_SCOPE("load job");
+            succeeded = job->work();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job->succeeded = succeeded;
+            completed_.push_back(job);
+        }
+        jobDone_.notify_one();
+    }
+}
+
+void AssetLoader::pump(int waitMs) {
+    std::vector<Job*> ready;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (completed_.empty() && waitMs > 0 && finished_ < static_cast<int>(jobs_.size())) {
+            jobDone_.wait_for(lock, std::chrono::milliseconds(waitMs),
+                              [this]() { return !completed_.empty(); });
+        }
+        ready.swap(completed_);
+    }
+
+    // finish steps touch the renderer, so they run here and not on a worker
+    int failed = 0;
+    for (Job* job : ready) {
+        if (job->succeeded) {
+            TRACE_SCOPE("finish job");
+            if (job->finish) job->finish();
+        } else {
+            ++failed;
+        }
+        job->work = nullptr;
+        job->finish = nullptr; // drops captured data like decoded pixels right away
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_ += static_cast<int>(ready.size());
+    failed_ += failed;
+}
+
+bool AssetLoader::isDone() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return finished_ == static_cast<int>(jobs_.size());
+}
+
+float AssetLoader::getProgress() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (jobs_.empty()) return 1.0f;
+    return static_cast<float>(finished_) / jobs_.size();
+}
+
+int AssetLoader::getFailedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
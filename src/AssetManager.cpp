@@ -0,0 +1,250 @@
+#include "../headers/AssetManager.h"
+#include "../headers/GameConstants.h"
+#include "../headers/AssetIO.h"
+#include "../headers/PixelCache.h"
+#include "../headers/ImageScale.h"
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+TextureAsset::~TextureAsset() {
+    // atlas regions borrow the page texture, the page frees it
+    if (texture && !page) SDL_DestroyTexture(texture);
+}
+
+DecodedImage::~DecodedImage() {
+    for (SDL_Surface* surface : levels) {
+        SDL_FreeSurface(surface);
+    }
+}
+
+AssetManager::AssetManager(SDL_Renderer* renderer)
+    : renderer_(renderer) {
+    if (renderer_) {
+        loadAtlasManifest(GameConstants::ATLAS_MANIFEST_PATH);
+    }
+}
+
+AssetManager::~AssetManager() {
+    textures_.clear();
+}
+
+TextureHandle AssetManager::getTexture(const std::string& path) {
+    auto it = textures_.find(path);
+    if (it != textures_.end()) {
+        return it->second;
+    }
+
+    // failed loads are cached too so a missing file doesnt get retried every spawn
+    auto region = atlasRegions_.find(path);
+    TextureHandle handle = (region != atlasRegions_.end()) ? loadRegion(region->second)
+                                                           : loadTexture(path);
+    textures_[path] = handle;
+    return handle;
+}
+
+bool AssetManager::preload(const std::string& path) {
+    return getTexture(path) != nullptr;
+}
+
+TextureHandle AssetManager::levelFor(const TextureHandle& texture, int drawW, int drawH) {
+    if (!texture) return texture;
+
+    const TextureHandle* best = &texture;
+    for (const TextureHandle& level : texture->levels) {
+        if (level->source.w < drawW || level->source.h < drawH) break;
+        best = &level;
+    }
+    return *best;
+}
+
+TextureHandle AssetManager::loadTexture(const std::string& path) {
+    if (!renderer_) return loadSizeOnly(path);
+
+    DecodedImage image;
+    if (!decodeImage(path, image, !isAtlasPage(path))) return nullptr;
+    return uploadDecoded(path, image);
+}
+
+bool AssetManager::decodeImage(const std::string& path, DecodedImage& image, bool withLevels) {
+    // decoded on an earlier run, mip levels included
+    if (PixelCache::load(path, image.levels)) return true;
+
+    SDL_Surface* loaded = IMG_Load_RW(AssetIO::open(path), 1);
+    if (!loaded) {
+        std::cerr << "Failed to load " << path << ": " << IMG_GetError() << std::endl;
+        return false;
+    }
+
+    // known byte order for the downscaler
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    if (!surface) {
+        std::cerr << "Failed to convert " << path << ": " << SDL_GetError() << std::endl;
+        return false;
+    }
+    image.levels.push_back(surface);
+
+    // each level is made from the one before, so its a quarter of the work every step
+    for (int level = 0; withLevels && level < GameConstants::TEXTURE_MIP_LEVELS; ++level) {
+        SDL_Surface* previous = image.levels.back();
+        if (previous->w < 2 || previous->h < 2) break;
+
+        SDL_Surface* half = ImageScale::half(previous);
+        if (!half) break;
+        image.levels.push_back(half);
+    }
+
+    PixelCache::store(path, image.levels);
+    return true;
+}
+
+TextureHandle AssetManager::addDecoded(const std::string& path, const DecodedImage& image) {
+    auto it = textures_.find(path);
+    if (it != textures_.end()) {
+        return it->second;
+    }
+
+    TextureHandle handle = uploadDecoded(path, image);
+    textures_[path] = handle;
+    return handle;
+}
+
+std::string AssetManager::getSourceFile(const std::string& path) const {
+    auto region = atlasRegions_.find(path);
+    return region != atlasRegions_.end() ? region->second.page : path;
+}
+
+TextureHandle AssetManager::uploadDecoded(const std::string& path, const DecodedImage& image) {
+    if (image.levels.empty()) return nullptr;
+
+    TextureHandle handle = uploadSurface(image.levels[0]);
+    if (!handle) {
+        std::cerr << "Failed to create texture for " << path << ": " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+
+    // an atlas page is sampled through the variants packed into it, smaller
+    // copies of the whole page would only be bound again and break the batch
+    // (an old pixel cache entry can still carry them)
+    if (isAtlasPage(path)) return handle;
+
+    for (size_t level = 1; level < image.levels.size(); ++level) {
+        TextureHandle scaled = uploadSurface(image.levels[level]);
+        if (!scaled) break;
+        handle->levels.push_back(scaled);
+    }
+    return handle;
+}
+
+TextureHandle AssetManager::uploadSurface(SDL_Surface* surface) {
+    // surfaces are always rgba32 here, so the pixels go up as they are with no conversion
+    SDL_Texture* texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                             surface->w, surface->h);
+    if (!texture) return nullptr;
+    if (SDL_UpdateTexture(texture, nullptr, surface->pixels, surface->pitch) != 0) {
+        SDL_DestroyTexture(texture);
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    TextureHandle handle = std::make_shared<TextureAsset>();
+    handle->texture = texture;
+    handle->width = surface->w;
+    handle->height = surface->h;
+    handle->source = SDL_Rect{0, 0, surface->w, surface->h};
+    handle->textureWidth = surface->w;
+    handle->textureHeight = surface->h;
+    return handle;
+}
+
+TextureHandle AssetManager::loadRegion(const AtlasRegion& region) {
+    TextureHandle page = getTexture(region.page);
+    if (!page) return nullptr;
+
+    TextureHandle handle = makeRegion(page, region.rect);
+
+    // the downscaled variants are regions of the same page, so whichever one
+    // levelFor picks the scene still draws from one texture
+    for (const SDL_Rect& rect : region.levels) {
+        handle->levels.push_back(makeRegion(page, rect));
+    }
+    return handle;
+}
+
+TextureHandle AssetManager::makeRegion(const TextureHandle& page, const SDL_Rect& rect) {
+    TextureHandle handle = std::make_shared<TextureAsset>();
+    handle->texture = page->texture;
+    handle->width = rect.w;
+    handle->height = rect.h;
+    handle->source = rect;
+    handle->textureWidth = page->textureWidth;
+    handle->textureHeight = page->textureHeight;
+    handle->page = page;
+    return handle;
+}
+
+void AssetManager::loadAtlasManifest(const std::string& manifestPath) {
+    std::string contents;
+    if (!AssetIO::readFile(manifestPath, contents)) return; // no atlas built, every sprite loads from its own png
+    std::istringstream manifest(contents);
+
+    // written by tools/AtlasPacker.cpp:
+    //   page <atlas png> <width> <height>
+    //   sprite <source png> <x> <y> <w> <h>
+    //   level <source png> <n> <x> <y> <w> <h>   n-th halving of that sprite, 1 = half size
+    std::string line, kind, page;
+    while (std::getline(manifest, line)) {
+        std::istringstream fields(line);
+        if (!(fields >> kind) || kind[0] == '#') continue;
+
+        if (kind == "page") {
+            fields >> page;
+            atlasPages_.insert(page);
+        } else if (kind == "sprite") {
+            std::string path;
+            SDL_Rect rect;
+            if (fields >> path >> rect.x >> rect.y >> rect.w >> rect.h && !page.empty()) {
+                atlasRegions_[path] = AtlasRegion{page, rect, {}};
+            }
+        } else if (kind == "level") {
+            // listed in order after their sprite, anything out of order is dropped
+            std::string path;
+            size_t level;
+            SDL_Rect rect;
+            if (fields >> path >> level >> rect.x >> rect.y >> rect.w >> rect.h) {
+                auto region = atlasRegions_.find(path);
+                if (region != atlasRegions_.end() && region->second.levels.size() + 1 == level) {
+                    region->second.levels.push_back(rect);
+                }
+            }
+        }
+    }
+}
+
+TextureHandle AssetManager::loadSizeOnly(const std::string& path) {
+    // signature (8) + IHDR chunk length/type (8) + width (4) + height (4)
+    unsigned char header[24];
+    SDL_RWops* file = AssetIO::open(path);
+    size_t read = file ? SDL_RWread(file, header, 1, sizeof(header)) : 0;
+    if (file) SDL_RWclose(file);
+    if (read != sizeof(header)) {
+        std::cerr << "Failed to read " << path << std::endl;
+        return nullptr;
+    }
+
+    static const unsigned char pngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (std::memcmp(header, pngSignature, 8) != 0 || std::memcmp(header + 12, "IHDR", 4) != 0) {
+        std::cerr << path << " is not a png" << std::endl;
+        return nullptr;
+    }
+
+    // png stores sizes big endian
+    TextureHandle handle = std::make_shared<TextureAsset>();
+    handle->width = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+    handle->height = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+    handle->source = SDL_Rect{0, 0, handle->width, handle->height};
+    return handle;
+}
@@ -1,43 +1,41 @@
 #include "../headers/Asteroid.h"
-#include <SDL2/SDL_image.h>
-#include <cstdlib>
+#include "../headers/Random.h"
 #include <cmath>
 
-Asteroid::Asteroid(SDL_Renderer* renderer, const std::string& texturePath,
-                   int screenW, int screenH, float playerX, float playerY)
-    : renderer_(renderer), texture_(nullptr),
-      screenW_(screenW), screenH_(screenH)
+// texture must be a loaded handle, Game checks before spawning
+Asteroid::Asteroid(TextureHandle texture, Random& rng, int screenW, int screenH, float playerX, float playerY)
+    : texture_(std::move(texture))
 {
-    SDL_Surface* surface = IMG_Load(texturePath.c_str());
-    if (!surface) return;
-
-    texture_ = SDL_CreateTextureFromSurface(renderer, surface);
-
     // randomize size of asteroid
-    float scale = 0.2f + static_cast<float>(rand()) / RAND_MAX * 0.3f;
+    float scale = rng.range(0.2f, 0.5f);
 
-    int w = static_cast<int>(surface->w * scale);
-    int h = static_cast<int>(surface->h * scale);
-    SDL_FreeSurface(surface);
+    int w = static_cast<int>(texture_->width * scale);
+    int h = static_cast<int>(texture_->height * scale);
 
     // Random rotation speed between -90 and 90 degrees/sec
-    rotationSpeed_ = -90.0f + static_cast<float>(rand()) / RAND_MAX * 180.0f;
-    angle_ = static_cast<float>(rand() % 360); // random initial angle
+    rotationSpeed_ = rng.range(-90.0f, 90.0f);
+    angle_ = static_cast<float>(rng.below(360)); // random initial angle
 
     rect_.w = w;
     rect_.h = h;
 
+    // draw from the closest pre-downscaled copy instead of the full size image
+    texture_ = AssetManager::levelFor(texture_, w, h);
+
     // spawn outside the screen randomly
-    int side = rand() % 4;
+    int side = rng.below(4);
     switch (side) {
-        case 0: x_ = rand() % screenW_; y_ = -h; break;           // top
-        case 1: x_ = rand() % screenW_; y_ = screenH_; break;     // bottom
-        case 2: x_ = -w; y_ = rand() % screenH_; break;           // left
-        case 3: x_ = screenW_; y_ = rand() % screenH_; break;     // right
+        case 0: x_ = rng.below(screenW); y_ = -h; break;           // top
+        case 1: x_ = rng.below(screenW); y_ = screenH; break;      // bottom
+        case 2: x_ = -w; y_ = rng.below(screenH); break;           // left
+        case 3: x_ = screenW; y_ = rng.below(screenH); break;      // right
     }
 
+    rect_.x = static_cast<int>(x_);
+    rect_.y = static_cast<int>(y_);
+
     // give each asteroid a random speed
-    speed_ = 100.0f + rand() % 400;
+    speed_ = 100.0f + rng.below(400);
 
     // direction toward player
     float dx = playerX - x_;
@@ -46,40 +44,3 @@ Asteroid::Asteroid(SDL_Renderer* renderer, const std::string& texturePath,
     vx_ = (dx / len) * speed_;
     vy_ = (dy / len) * speed_;
 }
-
-Asteroid::~Asteroid() {
-    if (texture_) SDL_DestroyTexture(texture_);
-}
-
-void Asteroid::update(float deltaTime, float playerX, float playerY) {
-
-    angle_ += rotationSpeed_ * deltaTime;
-
-    // keep angle between 0–360
-    if (angle_ >= 360.0f) angle_ -= 360.0f;
-    else if (angle_ < 0.0f) angle_ += 360.0f;
-
-    // adjust velocity slightly toward player's current position (homing effect)
-    float dx = playerX - x_;
-    float dy = playerY - y_;
-    float len = std::sqrt(dx * dx + dy * dy);
-    if (len > 0) {
-        vx_ = (dx / len) * speed_;
-        vy_ = (dy / len) * speed_;
-    }
-
-    x_ += vx_ * deltaTime;
-    y_ += vy_ * deltaTime;
-
-    rect_.x = static_cast<int>(x_);
-    rect_.y = static_cast<int>(y_);
-}
-
-void Asteroid::render() {
-    if (texture_) SDL_RenderCopyEx(renderer_, texture_, nullptr, &rect_, angle_, nullptr, SDL_FLIP_NONE);
-}
-
-bool Asteroid::isOffScreen() const {
-    return x_ < -rect_.w * 2 || x_ > screenW_ + rect_.w * 2 ||
-           y_ < -rect_.h * 2 || y_ > screenH_ + rect_.h * 2;
-}
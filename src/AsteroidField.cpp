@@ -0,0 +1,224 @@
+#include "../headers/AsteroidField.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// reference version of the asteroid step, the simd loops below do the
+// exact same float ops in the same order so every path gives identical results
+inline void stepAsteroid(float& x, float& y, float& vx, float& vy, float speed,
+                         float& angle, float rotationSpeed,
+                         float deltaTime, float playerX, float playerY) {
+    angle += rotationSpeed * deltaTime;
+
+    // keep angle between 0–360
+    if (angle >= 360.0f) angle -= 360.0f;
+    else if (angle < 0.0f) angle += 360.0f;
+
+    // adjust velocity toward player's current position (homing effect)
+    float dx = playerX - x;
+    float dy = playerY - y;
+    float len = std::sqrt(dx * dx + dy * dy);
+    if (len > 0) {
+        vx = (dx / len) * speed;
+        vy = (dy / len) * speed;
+    }
+
+    x += vx * deltaTime;
+    y += vy * deltaTime;
+}
+
+#if !defined(__AVX__) && defined(__SSE2__)
+// sse2 has no blendv, mask ? a : b the long way
+inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+}
+
+AsteroidField::AsteroidField(size_t capacity, int screenW, int screenH)
+    : count_(0), capacity_(capacity),
+      highWaterMark_(0), droppedSpawns_(0),
+      screenW_(screenW), screenH_(screenH),
+      x_(capacity), y_(capacity), prevX_(capacity), prevY_(capacity), vx_(capacity), vy_(capacity),
+      speed_(capacity), angle_(capacity), rotationSpeed_(capacity),
+      w_(capacity), h_(capacity), textures_(capacity) {
+}
+
+bool AsteroidField::spawn(const Asteroid& asteroid) {
+    if (count_ >= capacity_) {
+        ++droppedSpawns_;
+        return false;
+    }
+
+    size_t i = count_++;
+    x_[i] = asteroid.x_;
+    y_[i] = asteroid.y_;
+    prevX_[i] = asteroid.x_;
+    prevY_[i] = asteroid.y_;
+    vx_[i] = asteroid.vx_;
+    vy_[i] = asteroid.vy_;
+    speed_[i] = asteroid.speed_;
+    angle_[i] = asteroid.angle_;
+    rotationSpeed_[i] = asteroid.rotationSpeed_;
+    w_[i] = asteroid.rect_.w;
+    h_[i] = asteroid.rect_.h;
+    textures_[i] = asteroid.texture_;
+
+    if (count_ > highWaterMark_) highWaterMark_ = count_;
+    return true;
+}
+
+void AsteroidField::despawn(size_t index) {
+    size_t last = count_ - 1;
+    if (index != last) {
+        x_[index] = x_[last];
+        y_[index] = y_[last];
+        prevX_[index] = prevX_[last];
+        prevY_[index] = prevY_[last];
+        vx_[index] = vx_[last];
+        vy_[index] = vy_[last];
+        speed_[index] = speed_[last];
+        angle_[index] = angle_[last];
+        rotationSpeed_[index] = rotationSpeed_[last];
+        w_[index] = w_[last];
+        h_[index] = h_[last];
+        textures_[index] = std::move(textures_[last]);
+    }
+    textures_[last].reset();
+    --count_;
+}
+
+void AsteroidField::clear() {
+    for (size_t i = 0; i < count_; ++i) {
+        textures_[i].reset();
+    }
+    count_ = 0;
+}
+
+void AsteroidField::update(float deltaTime, float playerX, float playerY) {
+    updateRange(0, count_, deltaTime, playerX, playerY);
+}
+
+void AsteroidField::updateRange(size_t begin, size_t end, float deltaTime, float playerX, float playerY) {
+    float* x = x_.data();
+    float* y = y_.data();
+    float* vx = vx_.data();
+    float* vy = vy_.data();
+    const float* speed = speed_.data();
+    float* angle = angle_.data();
+    const float* rotationSpeed = rotationSpeed_.data();
+
+    std::copy(x + begin, x + end, prevX_.data() + begin);
+    std::copy(y + begin, y + end, prevY_.data() + begin);
+
+    size_t i = begin;
+
+#if defined(__AVX__)
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 px = _mm256_set1_ps(playerX);
+    const __m256 py = _mm256_set1_ps(playerY);
+    const __m256 fullTurn = _mm256_set1_ps(360.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (; i + 8 <= end; i += 8) {
+        __m256 a = _mm256_add_ps(_mm256_loadu_ps(angle + i),
+                                 _mm256_mul_ps(_mm256_loadu_ps(rotationSpeed + i), dt));
+        __m256 over = _mm256_cmp_ps(a, fullTurn, _CMP_GE_OQ);
+        __m256 under = _mm256_cmp_ps(a, zero, _CMP_LT_OQ);
+        a = _mm256_blendv_ps(_mm256_blendv_ps(a, _mm256_add_ps(a, fullTurn), under),
+                             _mm256_sub_ps(a, fullTurn), over);
+        _mm256_storeu_ps(angle + i, a);
+
+        __m256 posX = _mm256_loadu_ps(x + i);
+        __m256 posY = _mm256_loadu_ps(y + i);
+        __m256 dx = _mm256_sub_ps(px, posX);
+        __m256 dy = _mm256_sub_ps(py, posY);
+        __m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+        __m256 homing = _mm256_cmp_ps(len, zero, _CMP_GT_OQ);
+        __m256 s = _mm256_loadu_ps(speed + i);
+
+        __m256 velX = _mm256_blendv_ps(_mm256_loadu_ps(vx + i), _mm256_mul_ps(_mm256_div_ps(dx, len), s), homing);
+        __m256 velY = _mm256_blendv_ps(_mm256_loadu_ps(vy + i), _mm256_mul_ps(_mm256_div_ps(dy, len), s), homing);
+        _mm256_storeu_ps(vx + i, velX);
+        _mm256_storeu_ps(vy + i, velY);
+        _mm256_storeu_ps(x + i, _mm256_add_ps(posX, _mm256_mul_ps(velX, dt)));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(posY, _mm256_mul_ps(velY, dt)));
+    }
+#elif defined(__SSE2__)
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 px = _mm_set1_ps(playerX);
+    const __m128 py = _mm_set1_ps(playerY);
+    const __m128 fullTurn = _mm_set1_ps(360.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= end; i += 4) {
+        __m128 a = _mm_add_ps(_mm_loadu_ps(angle + i),
+                              _mm_mul_ps(_mm_loadu_ps(rotationSpeed + i), dt));
+        __m128 over = _mm_cmpge_ps(a, fullTurn);
+        __m128 under = _mm_cmplt_ps(a, zero);
+        a = select(over, _mm_sub_ps(a, fullTurn), select(under, _mm_add_ps(a, fullTurn), a));
+        _mm_storeu_ps(angle + i, a);
+
+        __m128 posX = _mm_loadu_ps(x + i);
+        __m128 posY = _mm_loadu_ps(y + i);
+        __m128 dx = _mm_sub_ps(px, posX);
+        __m128 dy = _mm_sub_ps(py, posY);
+        __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 homing = _mm_cmpgt_ps(len, zero);
+        __m128 s = _mm_loadu_ps(speed + i);
+
+        __m128 velX = select(homing, _mm_mul_ps(_mm_div_ps(dx, len), s), _mm_loadu_ps(vx + i));
+        __m128 velY = select(homing, _mm_mul_ps(_mm_div_ps(dy, len), s), _mm_loadu_ps(vy + i));
+        _mm_storeu_ps(vx + i, velX);
+        _mm_storeu_ps(vy + i, velY);
+        _mm_storeu_ps(x + i, _mm_add_ps(posX, _mm_mul_ps(velX, dt)));
+        _mm_storeu_ps(y + i, _mm_add_ps(posY, _mm_mul_ps(velY, dt)));
+    }
+#endif
+
+    // leftovers that dont fill a whole register (or everything without simd)
+    for (; i < end; ++i) {
+        stepAsteroid(x[i], y[i], vx[i], vy[i], speed[i], angle[i], rotationSpeed[i],
+                     deltaTime, playerX, playerY);
+    }
+}
+
+void AsteroidField::removeOffScreen() {
+    for (size_t i = 0; i < count_;) {
+        if (isOffScreen(i)) {
+            despawn(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void AsteroidField::appendSprites(std::vector<SpriteState>& sprites) const {
+    for (size_t i = 0; i < count_; ++i) {
+        sprites.push_back(SpriteState{textures_[i].get(), prevX_[i], prevY_[i], x_[i], y_[i],
+                                      static_cast<float>(w_[i]), static_cast<float>(h_[i]), angle_[i]});
+    }
+}
+
+bool AsteroidField::isOffScreen(size_t index) const {
+    return x_[index] < -w_[index] * 2 || x_[index] > screenW_ + w_[index] * 2 ||
+           y_[index] < -h_[index] * 2 || y_[index] > screenH_ + h_[index] * 2;
+}
+
+const char* AsteroidField::getKernelName() {
+#if defined(__AVX__)
+    return "avx";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,38 @@
+#include "../headers/AudioEvents.h"
+#include "../headers/GameConstants.h"
+
+AudioEventQueue::AudioEventQueue(size_t capacity)
+    : capacity_(capacity), coalesced_(0), dropped_(0),
+      listenerX_(0.0f), listenerY_(0.0f) {
+    events_.reserve(capacity_);
+}
+
+void AudioEventQueue::push(SoundEffect effect, float x, float y) {
+    const float radius = GameConstants::AUDIO_COALESCE_RADIUS;
+
+    // only a handful of events per frame, a linear scan beats anything clever
+    for (AudioEvent& event : events_) {
+        if (event.effect != effect) continue;
+
+        float dx = x - event.x;
+        float dy = y - event.y;
+        if (dx * dx + dy * dy > radius * radius) continue;
+
+        // running average so the merged sound sits in the middle of the cluster
+        ++event.count;
+        event.x += dx / event.count;
+        event.y += dy / event.count;
+        ++coalesced_;
+        return;
+    }
+
+    if (events_.size() >= capacity_) {
+        ++dropped_;
+        return;
+    }
+    events_.push_back(AudioEvent{effect, x, y, 1});
+}
+
+void AudioEventQueue::clear() {
+    events_.clear();
+}
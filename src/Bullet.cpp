@@ -1,20 +1,13 @@
 #include "../headers/Bullet.h"
-#include <SDL2/SDL_image.h>
 #include <cmath>
-#include <iostream>
 
-Bullet::Bullet(SDL_Renderer* renderer, const std::string& path, float startX, float startY, float targetX, float targetY)
-    : renderer_(renderer), texture_(nullptr), x_(startX), y_(startY), speed_(900.0f) // px/sec
+Bullet::Bullet(TextureHandle texture, float startX, float startY, float targetX, float targetY)
+    : texture_(std::move(texture)), x_(startX), y_(startY),
+      prevX_(startX), prevY_(startY), speed_(900.0f) // px/sec
 {
-    SDL_Surface* surface = IMG_Load(path.c_str());
-    if (!surface) {
-        std::cerr << "Failed to load bullet image: " << IMG_GetError() << std::endl;
-        return;
-    }
-    texture_ = SDL_CreateTextureFromSurface(renderer, surface);
     rect_.w = 50;
     rect_.h = 50;
-    SDL_FreeSurface(surface);
+    texture_ = AssetManager::levelFor(texture_, rect_.w, rect_.h);
 
     angle = atan2(targetY - startY, targetX - startX) * 180.0f / M_PI - 90.0f; // fix rotation[off by 90 degrees]
 
@@ -30,23 +23,24 @@ Bullet::Bullet(SDL_Renderer* renderer, const std::string& path, float startX, fl
     rect_.y = static_cast<int>(y_ - rect_.h / 2);
 }
 
-Bullet::~Bullet() {
-    if (texture_) SDL_DestroyTexture(texture_);
-}
-
 void Bullet::update(float deltaTime) {
+    prevX_ = x_;
+    prevY_ = y_;
     x_ += vx_ * deltaTime;
     y_ += vy_ * deltaTime;
     rect_.x = static_cast<int>(x_ - rect_.w / 2);
     rect_.y = static_cast<int>(y_ - rect_.h / 2);
 }
 
-void Bullet::render() {
-    if (!texture_) return;
+bool Bullet::getSprite(SpriteState& sprite) const {
+    if (!texture_) return false;
 
-    // rotate the bullet by its angle so it points in the movement direction
-    SDL_Point center = {rect_.w / 2, rect_.h / 2}; // rotate around center
-    SDL_RenderCopyEx(renderer_, texture_, nullptr, &rect_, angle + 90.0f, &center, SDL_FLIP_NONE);
+    // x/y are the centre, rotated by its angle so it points in the movement direction
+    float halfW = rect_.w / 2;
+    float halfH = rect_.h / 2;
+    sprite = SpriteState{texture_.get(), prevX_ - halfW, prevY_ - halfH, x_ - halfW, y_ - halfH,
+                         static_cast<float>(rect_.w), static_cast<float>(rect_.h), angle + 90.0f};
+    return true;
 }
 
 bool Bullet::isOffScreen() const {
@@ -0,0 +1,36 @@
+#include "../headers/FixedTimestep.h"
+
+FixedTimestep::FixedTimestep(int tickRate, int maxStepsPerFrame)
+    : stepSeconds_(1.0 / tickRate),
+      maxStepsPerFrame_(maxStepsPerFrame),
+      counterToSeconds_(1.0 / SDL_GetPerformanceFrequency()),
+      lastCounter_(SDL_GetPerformanceCounter()),
+      accumulator_(0.0),
+      droppedSteps_(0) {
+}
+
+int FixedTimestep::advance() {
+    Uint64 now = SDL_GetPerformanceCounter();
+    accumulator_ += (now - lastCounter_) * counterToSeconds_;
+    lastCounter_ = now;
+
+    int steps = static_cast<int>(accumulator_ / stepSeconds_);
+    accumulator_ -= steps * stepSeconds_;
+
+    if (steps > maxStepsPerFrame_) {
+        droppedSteps_ += steps - maxStepsPerFrame_;
+        steps = maxStepsPerFrame_;
+    }
+
+    return steps;
+}
+
+void FixedTimestep::reset() {
+    lastCounter_ = SDL_GetPerformanceCounter();
+    accumulator_ = 0.0;
+}
+
+double FixedTimestep::getSecondsUntilNextStep() const {
+    double elapsed = (SDL_GetPerformanceCounter() - lastCounter_) * counterToSeconds_;
+    return stepSeconds_ - accumulator_ - elapsed;
+}
@@ -0,0 +1,103 @@
+#include "../headers/FramePacer.h"
+#include "../headers/GameConstants.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+FramePacer::FramePacer(int targetFps)
+    : targetFps_(0), period_(0),
+      frequency_(SDL_GetPerformanceFrequency()),
+      nextDeadline_(0), lastFrame_(0),
+      frames_(0), sumMs_(0.0), sumSquaresMs_(0.0), worstMs_(0.0),
+      missedFrames_(0), sleptTicks_(0), spunTicks_(0) {
+    spinMargin_ = frequency_ * GameConstants::FRAME_SPIN_MARGIN_US / 1000000;
+    oversleepTicks_ = static_cast<double>(spinMargin_) / 2.0;
+    setTargetFps(targetFps);
+}
+
+void FramePacer::updateSpinMargin() {
+    // twice the typical oversleep covers most wakeups, between 100 us and FRAME_SPIN_MAX_US
+    Uint64 minimum = frequency_ / 10000;
+    Uint64 maximum = frequency_ * GameConstants::FRAME_SPIN_MAX_US / 1000000;
+    Uint64 wanted = static_cast<Uint64>(oversleepTicks_ * 2.0);
+    spinMargin_ = std::min(maximum, std::max(minimum, wanted));
+}
+
+void FramePacer::setTargetFps(int targetFps) {
+    targetFps_ = std::max(0, targetFps);
+    period_ = targetFps_ > 0 ? frequency_ / targetFps_ : 0;
+    nextDeadline_ = 0; // restart the schedule from the next frame
+}
+
+void FramePacer::wait() {
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    if (period_ > 0) {
+        if (nextDeadline_ == 0) {
+            nextDeadline_ = now + period_;
+        }
+
+        // sleep up to the spin margin, then yield the last bit away
+        if (nextDeadline_ > now + spinMargin_) {
+            Uint64 sleepTicks = nextDeadline_ - now - spinMargin_;
+            std::this_thread::sleep_for(std::chrono::microseconds(sleepTicks * 1000000 / frequency_));
+            Uint64 woke = SDL_GetPerformanceCounter();
+            sleptTicks_ += woke - now;
+
+            // the margin follows how late the os actually wakes us, a quiet
+            // machine gets a tiny spin and a busy one still makes its deadlines
+            double late = woke > now + sleepTicks ? static_cast<double>(woke - now - sleepTicks) : 0.0;
+            oversleepTicks_ += (late - oversleepTicks_) / 8.0;
+            updateSpinMargin();
+            now = woke;
+        }
+
+        Uint64 spinStart = now;
+        while (now < nextDeadline_) {
+            std::this_thread::yield();
+            now = SDL_GetPerformanceCounter();
+        }
+        spunTicks_ += now - spinStart;
+
+        // a frame that ran past its slot starts a new schedule instead of
+        // rushing out catch up frames back to back
+        nextDeadline_ += period_;
+        if (nextDeadline_ <= now) {
+            nextDeadline_ = now + period_;
+        }
+    }
+
+    recordInterval(now);
+}
+
+void FramePacer::recordInterval(Uint64 now) {
+    if (lastFrame_ != 0) {
+        double ms = (now - lastFrame_) * 1000.0 / frequency_;
+        ++frames_;
+        sumMs_ += ms;
+        sumSquaresMs_ += ms * ms;
+        worstMs_ = std::max(worstMs_, ms);
+        if (period_ > 0 && (now - lastFrame_) * 2 > period_ * 3) {
+            ++missedFrames_;
+        }
+    }
+    lastFrame_ = now;
+}
+
+FramePacingStats FramePacer::getStats() const {
+    FramePacingStats stats{};
+    stats.frames = frames_;
+    if (frames_ > 0) {
+        double average = sumMs_ / frames_;
+        double variance = std::max(0.0, sumSquaresMs_ / frames_ - average * average);
+        stats.averageMs = static_cast<float>(average);
+        stats.jitterMs = static_cast<float>(std::sqrt(variance));
+        stats.worstMs = static_cast<float>(worstMs_);
+    }
+    stats.missedFrames = missedFrames_;
+    stats.sleptMs = static_cast<float>(sleptTicks_ * 1000.0 / frequency_);
+    stats.spunMs = static_cast<float>(spunTicks_ * 1000.0 / frequency_);
+    stats.spinMarginUs = static_cast<float>(spinMargin_ * 1000000.0 / frequency_);
+    return stats;
+}
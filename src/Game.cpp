@@ -6,36 +6,85 @@
 #include "../headers/UIRenderer.h"
 #include "../headers/GameConstants.h"
 #include "../headers/Sound.h"
+#include "../headers/AssetManager.h"
+#include "../headers/InputRecording.h"
+#include "../headers/Profiler.h"
+#include "../headers/JobSystem.h"
 #include <algorithm>
+#include <cstring>
 
-Game::Game(SDL_Renderer* renderer, int screenWidth, int screenHeight, Sounds* sounds)
+Game::Game(SDL_Renderer* renderer, int screenWidth, int screenHeight, Sounds* sounds,
+           AssetManager* assets)
     : renderer_(renderer),
       screenWidth_(screenWidth),
       screenHeight_(screenHeight),
       sounds_(sounds),
+      assets_(assets),
+      ownsAssets_(assets == nullptr),
       player_(nullptr),
       roundManager_(nullptr),
       uiRenderer_(nullptr),
+      bullets_(GameConstants::MAX_BULLETS),
+      asteroids_(GameConstants::MAX_ASTEROIDS, screenWidth, screenHeight),
+      spriteBatch_(renderer),
+      audioEvents_(GameConstants::MAX_AUDIO_EVENTS),
+      collisionGrid_(screenWidth, screenHeight, GameConstants::COLLISION_CELL_SIZE),
+      jobs_(nullptr),
+      recorder_(nullptr),
+      seed_(GameConstants::DEFAULT_SEED),
+      roundLabelRound_(0),
       gameStarted_(false),
       gameOver_(false) {
-    
+
+    bulletHits_.reserve(GameConstants::MAX_BULLETS);
+    asteroidHits_.reserve(GameConstants::MAX_ASTEROIDS);
+    bulletTargets_.reserve(GameConstants::MAX_BULLETS);
+
+    // every sprite is decoded and uploaded once here, spawns only share handles.
+    // with a shared manager the loader usually got to them first and these are lookups
+    if (ownsAssets_) {
+        assets_ = new AssetManager(renderer);
+    }
+    assets_->preload(GameConstants::PLAYER_TEXTURE_PATH);
+    assets_->preload(GameConstants::BULLET_TEXTURE_PATH);
+    assets_->preload(GameConstants::ASTEROID_TEXTURE_PATH);
+    assets_->preload(GameConstants::ASTEROID2_TEXTURE_PATH);
+
     roundManager_ = new RoundManager();
-    uiRenderer_ = new UIRenderer(renderer, GameConstants::FONT_PATH,
-                                 GameConstants::ROUND_DISPLAY_FONT_SIZE,
-                                 GameConstants::ROUND_TRANSITION_FONT_SIZE);
+
+    // headless runs have no renderer and never draw text
+    if (renderer_) {
+        uiRenderer_ = new UIRenderer(renderer, GameConstants::FONT_PATH,
+                                     GameConstants::ROUND_DISPLAY_FONT_SIZE,
+                                     GameConstants::ROUND_TRANSITION_FONT_SIZE);
+    }
 }
 
 Game::~Game() {
     cleanup();
     if (roundManager_) delete roundManager_;
     if (uiRenderer_) delete uiRenderer_;
+    if (ownsAssets_) delete assets_;
+}
+
+int Game::getCurrentRound() const {
+    return roundManager_->getCurrentRound();
 }
 
 void Game::initialize() {
     if (!player_) {
-        player_ = new Player(renderer_, GameConstants::PLAYER_TEXTURE_PATH,
+        player_ = new Player(renderer_, assets_,
                            screenWidth_, screenHeight_,
-                           GameConstants::PLAYER_SCALE, sounds_);
+                           GameConstants::PLAYER_SCALE);
+    } else {
+        player_->reset(); // restarting after a game over
+    }
+
+    pendingInput_ = InputState();
+    audioEvents_.clear();
+    rng_.reseed(seed_);
+    if (renderer_) {
+        SDL_GetMouseState(&pendingInput_.mouseX, &pendingInput_.mouseY);
     }
     
     roundManager_->resetToRoundOne();
@@ -43,46 +92,104 @@ void Game::initialize() {
     gameOver_ = false;
     
     clearBullets();
-    for (auto* asteroid : asteroids_) delete asteroid;
     asteroids_.clear();
 }
 
 void Game::handleEvent(const SDL_Event& event) {
     if (!gameStarted_ || gameOver_) return;
 
+    // events only change the pending input, update() acts on it once per tick
+    std::lock_guard<std::mutex> lock(inputMutex_);
     if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT) {
-        player_->shoot(bullets_);
+        pendingInput_.shots++;
+        pendingInput_.mouseX = event.button.x;
+        pendingInput_.mouseY = event.button.y;
+    } else if (event.type == SDL_MOUSEMOTION) {
+        pendingInput_.mouseX = event.motion.x;
+        pendingInput_.mouseY = event.motion.y;
+    } else if ((event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) && !event.key.repeat) {
+        bool pressed = event.type == SDL_KEYDOWN;
+        switch (event.key.keysym.sym) {
+            case SDLK_w: pendingInput_.up = pressed; break;
+            case SDLK_s: pendingInput_.down = pressed; break;
+            case SDLK_a: pendingInput_.left = pressed; break;
+            case SDLK_d: pendingInput_.right = pressed; break;
+        }
     }
-    
-    player_->handleEvent(event);
+}
+
+void Game::setInput(const InputState& input) {
+    std::lock_guard<std::mutex> lock(inputMutex_);
+    pendingInput_ = input;
 }
 
 bool Game::update(float deltaTime) {
     if (!gameStarted_ || gameOver_) return !gameOver_;
+    PROFILE_SCOPE(Update);
 
-    roundManager_->updateTransitionTimer(deltaTime);
+    // taken as one piece so a tick never sees half of an event
+    InputState input;
+    {
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        input = pendingInput_;
+        pendingInput_.shots = 0; // held keys and aim carry over, clicks dont
+    }
 
-    if (roundManager_->shouldSpawnAsteroids(deltaTime)) {
-        spawnAsteroid(GameConstants::ASTEROID_TEXTURE_PATH,
-                     player_->getX(), player_->getY());
-        spawnAsteroid(GameConstants::ASTEROID2_TEXTURE_PATH,
-                     player_->getX(), player_->getY());
-        roundManager_->markAsteroidsSpawned(GameConstants::ASTEROIDS_PER_SPAWN_EVENT);
+    if (recorder_) recorder_->record(input);
+    player_->applyInput(input);
+    SDL_Rect muzzle = player_->getHitbox();
+    for (int i = 0; i < input.shots; ++i) {
+        // a full pool drops the bullet, and then there is no shot to hear either
+        if (player_->shoot(bullets_)) {
+            audioEvents_.push(SoundEffect::Shot, muzzle.x + muzzle.w / 2.0f, muzzle.y + muzzle.h / 2.0f);
+        }
     }
 
-    if (roundManager_->isRoundComplete(asteroids_.size())) {
-        roundManager_->advanceToNextRound();
-        clearBullets();
+    {
+        PROFILE_SCOPE(Spawn);
+        roundManager_->updateTransitionTimer(deltaTime);
+
+        if (roundManager_->shouldSpawnAsteroids(deltaTime)) {
+            spawnAsteroid(GameConstants::ASTEROID_TEXTURE_PATH,
+                         player_->getX(), player_->getY());
+            spawnAsteroid(GameConstants::ASTEROID2_TEXTURE_PATH,
+                         player_->getX(), player_->getY());
+            roundManager_->markAsteroidsSpawned(GameConstants::ASTEROIDS_PER_SPAWN_EVENT);
+        }
+
+        if (roundManager_->isRoundComplete(asteroids_.size())) {
+            roundManager_->advanceToNextRound();
+            clearBullets();
+        }
     }
 
     player_->update(deltaTime);
 
-    updateBullets(deltaTime);
-    updateAsteroids(deltaTime);
+    {
+        PROFILE_SCOPE(Bullets);
+        updateBullets(deltaTime);
+    }
+    {
+        PROFILE_SCOPE(Asteroids);
+        updateAsteroids(deltaTime);
+    }
 
-    checkBulletAsteroidCollisions();
-    
-    if (checkPlayerAsteroidCollisions()) {
+    bool playerHit;
+    {
+        PROFILE_SCOPE(Collisions);
+        checkBulletAsteroidCollisions();
+        playerHit = checkPlayerAsteroidCollisions();
+        removeDestroyed();
+    }
+
+    // the player is the listener, everything is panned relative to them
+    SDL_Rect playerBox = player_->getHitbox();
+    float playerCenterX = playerBox.x + playerBox.w / 2.0f;
+    float playerCenterY = playerBox.y + playerBox.h / 2.0f;
+    audioEvents_.setListener(playerCenterX, playerCenterY);
+
+    if (playerHit) {
+        audioEvents_.push(SoundEffect::Death, playerCenterX, playerCenterY);
         gameOver_ = true;
         return false;
     }
@@ -90,32 +197,98 @@ bool Game::update(float deltaTime) {
     return true;
 }
 
-void Game::render() {
-    if (!gameStarted_) return;
+uint64_t Game::getStateHash() const {
+    // fnv-1a over the raw bits, any drift in a float shows up
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    auto mixFloat = [&mix](float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        mix(&bits, sizeof(bits));
+    };
 
-    for (auto* asteroid : asteroids_) {
-        asteroid->render();
+    int round = getCurrentRound();
+    mix(&round, sizeof(round));
+    if (player_) {
+        mixFloat(player_->getX());
+        mixFloat(player_->getY());
     }
-    
-    for (auto* bullet : bullets_) {
-        bullet->render();
+    for (size_t i = 0; i < asteroids_.size(); ++i) {
+        mixFloat(asteroids_.getX(i));
+        mixFloat(asteroids_.getY(i));
+        mixFloat(asteroids_.getAngle(i));
     }
-    
-    player_->render();
+    for (const Bullet& bullet : bullets_) {
+        const SDL_Rect& rect = bullet.getRect();
+        mix(&rect, sizeof(rect));
+    }
+    return hash;
+}
+
+void Game::flushAudio() {
+    // a frame can run several ticks, everything they queued goes out in one batch
+    if (sounds_ && !audioEvents_.empty()) {
+        sounds_->playEvents(audioEvents_, screenWidth_, screenHeight_);
+    }
+    audioEvents_.clear();
+}
+
+void Game::captureSnapshot(GameSnapshot& snapshot) const {
+    // capacity stays from earlier snapshots, so after warmup this never allocates
+    snapshot.sprites.clear();
+    asteroids_.appendSprites(snapshot.sprites);
+    SpriteState sprite;
+    for (const auto& bullet : bullets_) {
+        if (bullet.getSprite(sprite)) snapshot.sprites.push_back(sprite);
+    }
+    // player goes in last so it still ends up on top, SpriteBatch keeps
+    // submission order whether or not everything shares the atlas texture
+    if (player_->getSprite(sprite)) snapshot.sprites.push_back(sprite);
+
+    snapshot.round = roundManager_->getCurrentRound();
+    snapshot.showingTransition = roundManager_->isShowingTransition();
+    snapshot.gameOver = gameOver_;
+}
+
+void Game::render(const GameSnapshot& snapshot, float alpha) {
+    if (!gameStarted_) return;
+    PROFILE_SCOPE(Render);
+
+    // one draw call per run of sprites on the same texture instead of one per
+    // entity. with the sprite atlas built every sprite shares one texture so
+    // the scene is one call, loose pngs take a call per texture switch
+    spriteBatch_.begin();
+    for (const SpriteState& sprite : snapshot.sprites) {
+        SDL_FRect dst{sprite.prevX + (sprite.x - sprite.prevX) * alpha,
+                      sprite.prevY + (sprite.y - sprite.prevY) * alpha,
+                      sprite.w, sprite.h};
+        spriteBatch_.draw(*sprite.texture, dst, sprite.angle);
+    }
+    spriteBatch_.flush();
 
     if (uiRenderer_ && uiRenderer_->isInitialized()) {
+        // label only changes once per round, same string keeps hitting the text cache
+        if (roundLabelRound_ != snapshot.round) {
+            roundLabelRound_ = snapshot.round;
+            roundLabel_ = "Round " + std::to_string(roundLabelRound_);
+        }
+
         // round number display 
-        std::string roundText = "Round " + std::to_string(roundManager_->getCurrentRound());
         SDL_Color white = {255, 255, 255, 255};
-        uiRenderer_->renderText(roundText,
+        uiRenderer_->renderText(roundLabel_,
                                 GameConstants::ROUND_TEXT_X_OFFSET,
                                 GameConstants::ROUND_TEXT_Y_OFFSET,
                                 0, white);
 
         // round transition display
-        if (roundManager_->isShowingTransition()) {
-            std::string transitionText = "Round " + std::to_string(roundManager_->getCurrentRound());
-            uiRenderer_->renderTextCentered(transitionText,
+        if (snapshot.showingTransition) {
+            uiRenderer_->renderTextCentered(roundLabel_,
                                           screenWidth_ / 2,
                                           screenHeight_ / 2,
                                           1, white);
@@ -124,78 +297,126 @@ void Game::render() {
 }
 
 void Game::spawnAsteroid(const std::string& texturePath, float playerX, float playerY) {
-    asteroids_.push_back(new Asteroid(renderer_, texturePath,
-                                     screenWidth_, screenHeight_,
-                                     playerX, playerY));
+    TextureHandle texture = assets_->getTexture(texturePath);
+    if (!texture) return;
+
+    asteroids_.spawn(Asteroid(texture, rng_, screenWidth_, screenHeight_,
+                              playerX, playerY));
 }
 
+// despawn swaps the last entity into slot i, so i is only advanced when nothing was removed
 void Game::updateBullets(float deltaTime) {
-    for (auto it = bullets_.begin(); it != bullets_.end();) {
-        (*it)->update(deltaTime);
-        
-        if ((*it)->isOffScreen()) {
-            delete *it;
-            it = bullets_.erase(it);
+    for (size_t i = 0; i < bullets_.size();) {
+        bullets_[i].update(deltaTime);
+
+        if (bullets_[i].isOffScreen()) {
+            bullets_.despawn(i);
         } else {
-            ++it;
+            ++i;
         }
     }
 }
 
 void Game::updateAsteroids(float deltaTime) {
-    for (auto it = asteroids_.begin(); it != asteroids_.end();) {
-        (*it)->update(deltaTime, player_->getX(), player_->getY());
-        
-        if ((*it)->isOffScreen()) {
-            delete *it;
-            it = asteroids_.erase(it);
-        } else {
-            ++it;
-        }
+    // each asteroid only reads and writes its own slots, so chunks can run in any order
+    float playerX = player_->getX();
+    float playerY = player_->getY();
+    auto step = [&](size_t begin, size_t end) {
+        asteroids_.updateRange(begin, end, deltaTime, playerX, playerY);
+    };
+    if (jobs_) {
+        jobs_->parallelFor(asteroids_.size(), GameConstants::JOB_ASTEROID_GRAIN, step);
+    } else {
+        step(0, asteroids_.size());
     }
+
+    asteroids_.removeOffScreen();
+    collisionGrid_.rebuild(asteroids_);
+}
+
+size_t Game::findBulletTarget(size_t bullet, bool skipHit) const {
+    const SDL_Rect& bulletRect = bullets_[bullet].getRect();
+
+    // bullet can only hit one asteroid, the lowest index wins like a plain in order scan would
+    size_t target = asteroids_.size();
+    collisionGrid_.forEachCandidate(bulletRect, [&](size_t a) {
+        if (a >= target || (skipHit && asteroidHits_[a])) return;
+
+        SDL_Rect asteroidRect = asteroids_.getRect(a);
+        if (SDL_HasIntersection(&bulletRect, &asteroidRect)) {
+            target = a;
+        }
+    });
+    return target;
 }
 
 void Game::checkBulletAsteroidCollisions() {
-    for (auto bulletIt = bullets_.begin(); bulletIt != bullets_.end();) {
-        bool hit = false;
-        SDL_Rect bulletRect = (*bulletIt)->getRect();
-
-        for (auto asteroidIt = asteroids_.begin(); asteroidIt != asteroids_.end(); ++asteroidIt) {
-            if (SDL_HasIntersection(&bulletRect, &(*asteroidIt)->getRect())) {
-                delete *asteroidIt;
-                asteroids_.erase(asteroidIt);
-                hit = true;
-                break; // bullet can only hit one asteroid
-            }
+    bulletHits_.assign(bullets_.size(), 0);
+    asteroidHits_.assign(asteroids_.size(), 0);
+    bulletTargets_.resize(bullets_.size());
+
+    // the expensive part, every bullet against its grid cells, only reads shared state
+    auto scan = [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            bulletTargets_[b] = findBulletTarget(b, false);
         }
+    };
+    if (jobs_) {
+        jobs_->parallelFor(bullets_.size(), GameConstants::JOB_BULLET_GRAIN, scan);
+    } else {
+        scan(0, bullets_.size());
+    }
 
-        if (hit) {
-            delete *bulletIt;
-            bulletIt = bullets_.erase(bulletIt);
-        } else {
-            ++bulletIt;
+    // bullets claim their asteroid in index order, same as scanning them one by one.
+    // an asteroid an earlier bullet already took means a rescan past the taken ones,
+    // that only happens when two bullets touch the same asteroid in one tick.
+    // hits are only flagged here so indices (and the grid) stay valid while we scan
+    for (size_t b = 0; b < bullets_.size(); ++b) {
+        size_t target = bulletTargets_[b];
+        if (target < asteroids_.size() && asteroidHits_[target]) {
+            target = findBulletTarget(b, true);
+        }
+
+        if (target < asteroids_.size()) {
+            asteroidHits_[target] = 1;
+            bulletHits_[b] = 1;
         }
     }
 }
 
 bool Game::checkPlayerAsteroidCollisions() {
     SDL_Rect playerHitbox = player_->getHitbox();
-    
-    for (auto* asteroid : asteroids_) {
-        if (SDL_HasIntersection(&playerHitbox, &asteroid->getRect())) {
-            return true; // player hit!
+    bool hit = false;
+
+    // asteroids shot this tick are already gone as far as the player is concerned
+    collisionGrid_.forEachCandidate(playerHitbox, [&](size_t a) {
+        if (hit || asteroidHits_[a]) return;
+
+        SDL_Rect asteroidRect = asteroids_.getRect(a);
+        if (SDL_HasIntersection(&playerHitbox, &asteroidRect)) {
+            hit = true; // player hit!
         }
+    });
+
+    return hit;
+}
+
+void Game::removeDestroyed() {
+    // remove back to front, whatever gets swapped into a hole has already been checked
+    for (size_t a = asteroids_.size(); a-- > 0;) {
+        if (!asteroidHits_[a]) continue;
+
+        SDL_Rect rect = asteroids_.getRect(a);
+        audioEvents_.push(SoundEffect::Impact, rect.x + rect.w / 2.0f, rect.y + rect.h / 2.0f);
+        asteroids_.despawn(a);
+    }
+    for (size_t b = bullets_.size(); b-- > 0;) {
+        if (bulletHits_[b]) bullets_.despawn(b);
     }
-    
-    return false;
 }
 
 void Game::cleanup() {
     clearBullets();
-    
-    for (auto* asteroid : asteroids_) {
-        delete asteroid;
-    }
     asteroids_.clear();
     
     if (player_) {
@@ -205,8 +426,5 @@ void Game::cleanup() {
 }
 
 void Game::clearBullets() {
-    for (auto* bullet : bullets_) {
-        delete bullet;
-    }
     bullets_.clear();
 }
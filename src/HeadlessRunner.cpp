@@ -0,0 +1,129 @@
+#include "../headers/HeadlessRunner.h"
+#include "../headers/Game.h"
+#include "../headers/ScriptedInput.h"
+#include "../headers/InputRecording.h"
+#include "../headers/GameConstants.h"
+#include "../headers/Profiler.h"
+#include "../headers/Trace.h"
+#include "../headers/JobSystem.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <iostream>
+
+HeadlessRunner::HeadlessRunner(const LaunchOptions& options)
+    : options_(options) {
+}
+
+int HeadlessRunner::run() {
+    // a replay brings its own seed, tick rate and screen size, anything else would diverge
+    InputPlayback playback;
+    bool replaying = !options_.replayPath.empty();
+    RecordingHeader setup;
+    setup.seed = options_.seedSet ? options_.seed : GameConstants::DEFAULT_SEED;
+    setup.tickRate = options_.tickRate;
+    setup.screenWidth = GameConstants::SCREEN_WIDTH;
+    setup.screenHeight = GameConstants::SCREEN_HEIGHT;
+    if (replaying) {
+        if (!playback.open(options_.replayPath)) return 1;
+        setup = playback.getHeader();
+    }
+
+    Game game(nullptr,
+              setup.screenWidth,
+              setup.screenHeight,
+              nullptr);
+    ScriptedInput script(setup.screenWidth, setup.screenHeight);
+    game.setSeed(setup.seed);
+
+    // --threads counts this thread too, 0 - 1 leaves the pool to pick
+    JobSystem jobs(options_.threads - 1);
+    game.setJobSystem(&jobs);
+
+    InputRecorder recorder;
+    if (!options_.recordPath.empty()) {
+        if (!recorder.open(options_.recordPath, setup)) return 1;
+        game.setRecorder(&recorder);
+    }
+
+    game.initialize();
+
+    // each tick counts as a frame, there is nothing else to a headless frame
+    Profiler::setEnabled(options_.profile);
+
+    const float deltaTime = 1.0f / setup.tickRate;
+    const double ticksToSeconds = 1.0 / SDL_GetPerformanceFrequency();
+
+    int ticksRun = 0;
+    int gamesPlayed = 1;
+    int highestRound = 1;
+    double slowestTick = 0.0;
+    Uint64 runStart = SDL_GetPerformanceCounter();
+
+    while (replaying || ticksRun < options_.headlessTicks) {
+        InputState input;
+        if (replaying) {
+            if (!playback.next(input)) break;
+        } else {
+            input = script.next();
+        }
+
+        // soak tests keep going, a death just starts the next game. done lazily
+        // so a replay that ends on a death still ends on the same state as the recording
+        if (game.isGameOver()) {
+            game.initialize();
+            ++gamesPlayed;
+        }
+        game.setInput(input);
+
+        Uint64 tickStart = SDL_GetPerformanceCounter();
+        Profiler::beginFrame();
+        Trace::refill();
+        game.update(deltaTime);
+        game.flushAudio(); // no mixer here, just empties the queue
+        Profiler::endFrame();
+        slowestTick = std::max(slowestTick, (SDL_GetPerformanceCounter() - tickStart) * ticksToSeconds);
+
+        highestRound = std::max(highestRound, game.getCurrentRound());
+        ++ticksRun;
+    }
+
+    double elapsed = (SDL_GetPerformanceCounter() - runStart) * ticksToSeconds;
+    PoolStats bullets = game.getBulletPoolStats();
+    PoolStats asteroids = game.getAsteroidPoolStats();
+
+    std::cout << "headless: " << ticksRun << " ticks in " << elapsed << " s"
+              << (replaying ? " (replay of " + options_.replayPath + ")" : std::string()) << "\n"
+              << "  avg tick:   " << (ticksRun ? elapsed / ticksRun * 1e6 : 0.0) << " us\n"
+              << "  worst tick: " << slowestTick * 1e6 << " us\n"
+              << "  games played: " << gamesPlayed << ", highest round: " << highestRound << "\n"
+              << "  bullets peak " << bullets.highWaterMark << "/" << bullets.capacity
+              << " (dropped " << bullets.droppedSpawns << ")\n"
+              << "  asteroids peak " << asteroids.highWaterMark << "/" << asteroids.capacity
+              << " (dropped " << asteroids.droppedSpawns << ")\n"
+              << "  " << jobs.getThreadCount() << " threads, " << jobs.getStealCount() << " chunks stolen\n"
+              << "  seed " << setup.seed << ", final state hash " << std::hex << game.getStateHash() << std::dec << std::endl;
+
+    if (Trace::isEnabled() && Trace::write(GameConstants::TRACE_PATH)) {
+        std::cout << "  " << Trace::getEventCount() << " trace events written to " << GameConstants::TRACE_PATH << "\n";
+    }
+
+    if (options_.profile) {
+        std::cout << "  last " << Profiler::getFrameCount() << " ticks, ms p50 / p99:\n";
+        for (ProfileScope scope : {ProfileScope::Update, ProfileScope::Spawn, ProfileScope::Bullets,
+                                   ProfileScope::Asteroids, ProfileScope::Collisions}) {
+            ProfileStats stats = Profiler::getStats(scope);
+            std::cout << "    " << Profiler::getName(scope) << ": " << stats.p50Ms << " / " << stats.p99Ms << "\n";
+        }
+        if (Profiler::writeCsv(GameConstants::PROFILE_CSV_PATH)) {
+            std::cout << "  per tick timings written to " << GameConstants::PROFILE_CSV_PATH << "\n";
+        }
+        std::cout << std::flush;
+    }
+
+    if (recorder.isOpen()) {
+        recorder.close();
+        std::cout << "Recorded " << recorder.getTickCount() << " ticks to " << options_.recordPath << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include "../headers/ImageScale.h"
+#include <algorithm>
+
+SDL_Surface* ImageScale::half(SDL_Surface* source) {
+    int w = (source->w + 1) / 2;
+    int h = (source->h + 1) / 2;
+    SDL_Surface* half = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!half) return nullptr;
+
+    const Uint8* src = static_cast<const Uint8*>(source->pixels);
+    Uint8* dst = static_cast<Uint8*>(half->pixels);
+
+    for (int y = 0; y < h; ++y) {
+        int y0 = y * 2;
+        int y1 = std::min(y0 + 1, source->h - 1);
+        for (int x = 0; x < w; ++x) {
+            int x0 = x * 2;
+            int x1 = std::min(x0 + 1, source->w - 1);
+            const Uint8* block[4] = {
+                src + y0 * source->pitch + x0 * 4, src + y0 * source->pitch + x1 * 4,
+                src + y1 * source->pitch + x0 * 4, src + y1 * source->pitch + x1 * 4,
+            };
+
+            unsigned r = 0, g = 0, b = 0, a = 0;
+            for (const Uint8* p : block) {
+                r += p[0] * p[3];
+                g += p[1] * p[3];
+                b += p[2] * p[3];
+                a += p[3];
+            }
+
+            Uint8* out = dst + y * half->pitch + x * 4;
+            out[0] = a ? static_cast<Uint8>(r / a) : 0;
+            out[1] = a ? static_cast<Uint8>(g / a) : 0;
+            out[2] = a ? static_cast<Uint8>(b / a) : 0;
+            out[3] = static_cast<Uint8>((a + 2) / 4);
+        }
+    }
+    return half;
+}
@@ -0,0 +1,154 @@
+#include "../headers/InputRecording.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+// bump VERSION when the record layout changes
+const char MAGIC[8] = {'R', 'K', 'R', 'E', 'C', '0', '1', '\0'};
+const uint32_t VERSION = 1;
+
+const uint8_t FLAG_UP = 1 << 0;
+const uint8_t FLAG_DOWN = 1 << 1;
+const uint8_t FLAG_LEFT = 1 << 2;
+const uint8_t FLAG_RIGHT = 1 << 3;
+const uint8_t FLAG_AIM = 1 << 4;
+const uint8_t FLAG_SHOTS = 1 << 5;
+
+// recordings get passed between machines, so the byte order is fixed
+template <typename T>
+void writeValue(std::ofstream& out, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out.put(static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF));
+    }
+}
+
+template <typename T>
+bool readValue(const std::vector<unsigned char>& data, size_t& cursor, T& value) {
+    if (cursor + sizeof(T) > data.size()) return false;
+    uint64_t bits = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        bits |= static_cast<uint64_t>(data[cursor + i]) << (8 * i);
+    }
+    value = static_cast<T>(bits);
+    cursor += sizeof(T);
+    return true;
+}
+
+}
+
+InputRecorder::~InputRecorder() {
+    close();
+}
+
+bool InputRecorder::open(const std::string& path, const RecordingHeader& header) {
+    close();
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+        std::cerr << "Failed to open " << path << " for recording" << std::endl;
+        return false;
+    }
+    path_ = path;
+    ticks_ = 0;
+
+    // aim starts at 0,0 on both sides, so the first record always carries it
+    // unless the mouse really is in the corner
+    last_ = InputState();
+
+    out_.write(MAGIC, sizeof(MAGIC));
+    writeValue(out_, VERSION);
+    writeValue(out_, header.seed);
+    writeValue(out_, header.tickRate);
+    writeValue(out_, header.screenWidth);
+    writeValue(out_, header.screenHeight);
+    return static_cast<bool>(out_);
+}
+
+void InputRecorder::record(const InputState& input) {
+    if (!out_.is_open()) return;
+
+    uint8_t flags = 0;
+    if (input.up) flags |= FLAG_UP;
+    if (input.down) flags |= FLAG_DOWN;
+    if (input.left) flags |= FLAG_LEFT;
+    if (input.right) flags |= FLAG_RIGHT;
+    bool aimMoved = input.mouseX != last_.mouseX || input.mouseY != last_.mouseY;
+    if (aimMoved) flags |= FLAG_AIM;
+    if (input.shots > 0) flags |= FLAG_SHOTS;
+
+    writeValue(out_, flags);
+    if (aimMoved) {
+        writeValue(out_, static_cast<int32_t>(input.mouseX));
+        writeValue(out_, static_cast<int32_t>(input.mouseY));
+    }
+    if (input.shots > 0) {
+        // a tick is under 10 ms, nobody clicks 255 times in that
+        writeValue(out_, static_cast<uint8_t>(std::min(input.shots, 255)));
+    }
+
+    last_ = input;
+    ++ticks_;
+}
+
+void InputRecorder::close() {
+    if (!out_.is_open()) return;
+    out_.close();
+    if (!out_) {
+        std::cerr << "Failed to write recording " << path_ << std::endl;
+    }
+}
+
+bool InputPlayback::open(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Failed to open recording " << path << std::endl;
+        return false;
+    }
+    data_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    cursor_ = 0;
+    last_ = InputState();
+
+    uint32_t version = 0;
+    bool magicOk = data_.size() >= sizeof(MAGIC) && std::equal(MAGIC, MAGIC + sizeof(MAGIC), data_.begin());
+    cursor_ = sizeof(MAGIC);
+    if (!magicOk || !readValue(data_, cursor_, version) || version != VERSION) {
+        std::cerr << path << " is not a recording this build can play" << std::endl;
+        return false;
+    }
+    if (!readValue(data_, cursor_, header_.seed) || !readValue(data_, cursor_, header_.tickRate) ||
+        !readValue(data_, cursor_, header_.screenWidth) || !readValue(data_, cursor_, header_.screenHeight)) {
+        std::cerr << path << " has a truncated header" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool InputPlayback::next(InputState& input) {
+    uint8_t flags;
+    if (!readValue(data_, cursor_, flags)) return false;
+
+    InputState state;
+    state.up = flags & FLAG_UP;
+    state.down = flags & FLAG_DOWN;
+    state.left = flags & FLAG_LEFT;
+    state.right = flags & FLAG_RIGHT;
+    state.mouseX = last_.mouseX;
+    state.mouseY = last_.mouseY;
+
+    if (flags & FLAG_AIM) {
+        int32_t x, y;
+        if (!readValue(data_, cursor_, x) || !readValue(data_, cursor_, y)) return false;
+        state.mouseX = x;
+        state.mouseY = y;
+    }
+    if (flags & FLAG_SHOTS) {
+        uint8_t shots;
+        if (!readValue(data_, cursor_, shots)) return false;
+        state.shots = shots;
+    }
+
+    last_ = state;
+    input = state;
+    return true;
+}
@@ -0,0 +1,117 @@
+#include "../headers/JobSystem.h"
+#include "../headers/Trace.h"
+#include <algorithm>
+
+JobSystem::JobSystem(int workerCount)
+    : fn_(nullptr), context_(nullptr), count_(0), grain_(1),
+      remaining_(0), steals_(0), generation_(0), stopping_(false) {
+    if (workerCount < 0) {
+        workerCount = std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+
+    for (int i = 0; i <= workerCount; ++i) {
+        deques_.push_back(std::make_unique<Deque>());
+        deques_.back()->chunks.reserve(MAX_CHUNKS_PER_THREAD);
+    }
+    for (int i = 1; i <= workerCount; ++i) {
+        workers_.emplace_back(&JobSystem::workerLoop, this, static_cast<size_t>(i));
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void JobSystem::run(size_t count, size_t grain, ChunkFn fn, void* context) {
+    const size_t threads = deques_.size();
+    size_t chunks = (count + grain - 1) / grain;
+    if (chunks > threads * MAX_CHUNKS_PER_THREAD) {
+        grain = (count + threads * MAX_CHUNKS_PER_THREAD - 1) / (threads * MAX_CHUNKS_PER_THREAD);
+        chunks = (count + grain - 1) / grain;
+    }
+
+    fn_ = fn;
+    context_ = context;
+    count_ = count;
+    grain_ = grain;
+    // set before any chunk can be taken, nobody can finish one early
+    remaining_.store(chunks, std::memory_order_relaxed);
+
+    // neighbouring chunks go to the same thread, they tend to touch neighbouring memory
+    for (size_t t = 0; t < threads; ++t) {
+        Deque& deque = *deques_[t];
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        deque.chunks.clear();
+        for (size_t c = t * chunks / threads; c < (t + 1) * chunks / threads; ++c) {
+            deque.chunks.push_back(c);
+        }
+        deque.head = 0;
+        deque.tail = deque.chunks.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    runChunks(0);
+
+    // the last chunks can still be running on workers, they are short
+    while (remaining_.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+}
+
+void JobSystem::workerLoop(size_t self) {
+    Trace::setThreadName("job worker");
+    Uint64 seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wake_.wait(lock, [this, seen]() { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+        }
+        runChunks(self);
+    }
+}
+
+void JobSystem::runChunks(size_t self) {
+    TRACE_SCOPE("jobs");
+    size_t chunk;
+    while (pop(self, chunk) || steal(self, chunk)) {
+        size_t begin = chunk * grain_;
+        size_t end = std::min(begin + grain_, count_);
+        fn_(context_, begin, end);
+        remaining_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+bool JobSystem::pop(size_t self, size_t& chunk) {
+    Deque& deque = *deques_[self];
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    if (deque.head == deque.tail) return false;
+    chunk = deque.chunks[--deque.tail];
+    return true;
+}
+
+bool JobSystem::steal(size_t self, size_t& chunk) {
+    // start at the next thread over so thieves dont all pile onto deque 0
+    for (size_t i = 1; i < deques_.size(); ++i) {
+        Deque& victim = *deques_[(self + i) % deques_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.head == victim.tail) continue;
+        chunk = victim.chunks[victim.head++];
+        steals_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
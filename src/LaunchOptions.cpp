@@ -0,0 +1,128 @@
+#include "../headers/LaunchOptions.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+// reads the number after a switch, false if its missing or not a positive integer
+bool readPositiveInt(int argc, char* argv[], int& i, int& out) {
+    if (i + 1 >= argc) return false;
+    char* end = nullptr;
+    long value = std::strtol(argv[i + 1], &end, 10);
+    if (*end != '\0' || value <= 0) return false;
+    out = static_cast<int>(value);
+    ++i;
+    return true;
+}
+
+// seeds can be anything 64 bit, zero included
+bool readSeed(int argc, char* argv[], int& i, uint64_t& out) {
+    if (i + 1 >= argc || argv[i + 1][0] == '-') return false;
+    char* end = nullptr;
+    unsigned long long value = std::strtoull(argv[i + 1], &end, 0);
+    if (*end != '\0' || end == argv[i + 1]) return false;
+    out = value;
+    ++i;
+    return true;
+}
+
+bool readPath(int argc, char* argv[], int& i, std::string& out) {
+    if (i + 1 >= argc) return false;
+    out = argv[++i];
+    return true;
+}
+
+}
+
+bool LaunchOptions::parse(int argc, char* argv[], LaunchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+
+        if (std::strcmp(arg, "--headless") == 0) {
+            options.headless = true;
+        } else if (std::strcmp(arg, "--ticks") == 0) {
+            if (!readPositiveInt(argc, argv, i, options.headlessTicks)) {
+                std::cerr << "--ticks needs a positive number" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--tick-rate") == 0) {
+            if (!readPositiveInt(argc, argv, i, options.tickRate)) {
+                std::cerr << "--tick-rate needs a positive number" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--low-latency-audio") == 0) {
+            options.lowLatencyAudio = true;
+        } else if (std::strcmp(arg, "--audio-buffer") == 0) {
+            if (!readPositiveInt(argc, argv, i, options.audioBufferSamples)) {
+                std::cerr << "--audio-buffer needs a positive number" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--no-vsync") == 0) {
+            options.vsync = false;
+        } else if (std::strcmp(arg, "--fps") == 0) {
+            if (!readPositiveInt(argc, argv, i, options.targetFps)) {
+                std::cerr << "--fps needs a positive number" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            if (!readPositiveInt(argc, argv, i, options.threads)) {
+                std::cerr << "--threads needs a positive number" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--profile") == 0) {
+            options.profile = true;
+        } else if (std::strcmp(arg, "--trace") == 0) {
+            options.trace = true;
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            if (!readSeed(argc, argv, i, options.seed)) {
+                std::cerr << "--seed needs a number" << std::endl;
+                return false;
+            }
+            options.seedSet = true;
+        } else if (std::strcmp(arg, "--record") == 0) {
+            if (!readPath(argc, argv, i, options.recordPath)) {
+                std::cerr << "--record needs a file name" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--replay") == 0) {
+            if (!readPath(argc, argv, i, options.replayPath)) {
+                std::cerr << "--replay needs a file name" << std::endl;
+                return false;
+            }
+            options.headless = true; // replays only run headless
+        } else {
+            if (std::strcmp(arg, "--help") != 0) {
+                std::cerr << "Unknown option: " << arg << std::endl;
+            }
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    if (!options.replayPath.empty() && !options.recordPath.empty()) {
+        std::cerr << "--record and --replay cant be used together" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void LaunchOptions::printUsage(const char* program) {
+    std::cout << "usage: " << program << " [options]\n"
+              << "  --headless    run the game logic without a window, with scripted input\n"
+              << "  --ticks N     simulation ticks for a headless run (default 72000)\n"
+              << "  --tick-rate N simulation ticks per second (default " << GameConstants::SIMULATION_TICK_RATE << ")\n"
+              << "  --low-latency-audio  256 sample audio buffer and 16 voices instead of 2048 and 8\n"
+              << "  --audio-buffer N     audio buffer size in samples, overrides the mode default\n"
+              << "  --seed N      seed for the asteroid rng (default: clock, or " << GameConstants::DEFAULT_SEED << " headless)\n"
+              << "  --record FILE write every tick's input to FILE for --replay\n"
+              << "  --replay FILE replay a recording headless, ticks and tick rate come from the file\n"
+              << "  --profile     time every frame from the start, F3 shows the numbers, written to "
+              << GameConstants::PROFILE_CSV_PATH << " on exit\n"
+              << "  --trace       record a timeline of every thread from startup, F4 writes it to "
+              << GameConstants::TRACE_PATH << " (and so does exiting)\n"
+              << "  --no-vsync    dont wait for the display on present, the frame limiter paces instead\n"
+              << "  --fps N       frame limit (default: none with vsync, the display refresh rate without)\n"
+              << "  --threads N   threads the asteroid step and collisions are split over (default: core count, 1 = off)\n"
+              << "  --help        show this message" << std::endl;
+}
@@ -0,0 +1,24 @@
+#include "../headers/LoadingScreen.h"
+#include <algorithm>
+
+LoadingScreen::LoadingScreen(SDL_Renderer* renderer, int screenWidth, int screenHeight)
+    : renderer_(renderer) {
+    // bar across the middle third of the screen
+    int width = screenWidth / 3;
+    int height = 24;
+    frameRect_ = SDL_Rect{(screenWidth - width) / 2, (screenHeight - height) / 2, width, height};
+}
+
+void LoadingScreen::render(float progress) {
+    progress = std::clamp(progress, 0.0f, 1.0f);
+
+    SDL_SetRenderDrawColor(renderer_, 255, 255, 255, 255);
+    SDL_RenderDrawRect(renderer_, &frameRect_);
+
+    // fill sits 3px inside the outline
+    SDL_Rect fill{frameRect_.x + 3, frameRect_.y + 3,
+                  static_cast<int>((frameRect_.w - 6) * progress), frameRect_.h - 6};
+    if (fill.w > 0) {
+        SDL_RenderFillRect(renderer_, &fill);
+    }
+}
@@ -0,0 +1,273 @@
+#include "../headers/MusicStream.h"
+#include "../headers/AssetIO.h"
+#include "../headers/Trace.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+// ~0.5 s of audio per decode at 44.1 kHz, small enough that one run in flight
+// is cheap, big enough that the per run decoder setup doesnt matter
+const int SEGMENT_FRAMES = 20;
+// decoded ahead of every run but the first and dropped, mp3 frames can lean
+// on up to 511 bytes of the frames before them plus the previous frame's overlap
+const int PRE_ROLL_FRAMES = 2;
+
+// kbps, [mpeg1 or not][index]
+const int BITRATES[2][16] = {
+    {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0},       // mpeg2 / 2.5 layer 3
+    {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0},  // mpeg1 layer 3
+};
+const int SAMPLE_RATES[3] = {44100, 48000, 32000};
+
+}
+
+MusicStream::MusicStream()
+    : source_(nullptr), audioStart_(0), sampleRate_(0), samplesPerFrame_(0),
+      deviceFrequency_(0), deviceFrameBytes_(0), ringMask_(0),
+      writeIndex_(0), readIndex_(0),
+      running_(false), hooked_(false), underruns_(0), segmentsDecoded_(0) {
+}
+
+MusicStream::~MusicStream() {
+    stop();
+    if (source_) SDL_RWclose(source_);
+}
+
+bool MusicStream::parseFrameHeader(const Uint8* header, FrameInfo& info) {
+    if (header[0] != 0xFF || (header[1] & 0xE0) != 0xE0) return false;
+
+    int version = (header[1] >> 3) & 0x03; // 0 = 2.5, 2 = 2, 3 = 1
+    int layer = (header[1] >> 1) & 0x03;   // 1 = layer 3
+    int bitrateIndex = (header[2] >> 4) & 0x0F;
+    int rateIndex = (header[2] >> 2) & 0x03;
+    int padding = (header[2] >> 1) & 0x01;
+    if (version == 1 || layer != 1 || bitrateIndex == 0 || bitrateIndex == 15 || rateIndex == 3) return false;
+
+    bool mpeg1 = version == 3;
+    int bitrate = BITRATES[mpeg1 ? 1 : 0][bitrateIndex] * 1000;
+    info.sampleRate = SAMPLE_RATES[rateIndex] >> (mpeg1 ? 0 : (version == 2 ? 1 : 2));
+    info.samplesPerFrame = mpeg1 ? 1152 : 576;
+    info.length = (mpeg1 ? 144 : 72) * bitrate / info.sampleRate + padding;
+    return true;
+}
+
+bool MusicStream::readFrame(std::vector<Uint8>& out, FrameInfo& info) {
+    Uint8 header[4];
+    // resync byte by byte if something between frames isnt a frame (tags, junk)
+    for (;;) {
+        if (SDL_RWread(source_, header, 1, 4) != 4) return false;
+        if (parseFrameHeader(header, info)) break;
+        SDL_RWseek(source_, -3, RW_SEEK_CUR);
+    }
+
+    size_t start = out.size();
+    out.resize(start + info.length);
+    std::memcpy(out.data() + start, header, 4);
+    if (SDL_RWread(source_, out.data() + start + 4, 1, info.length - 4) != static_cast<size_t>(info.length - 4)) {
+        out.resize(start);
+        return false;
+    }
+    return true;
+}
+
+bool MusicStream::open(const std::string& path, int bufferMs) {
+    source_ = AssetIO::open(path);
+    if (!source_) return false;
+
+    // skip an id3v2 tag, its size is stored 7 bits per byte
+    Uint8 tag[10];
+    audioStart_ = 0;
+    if (SDL_RWread(source_, tag, 1, 10) == 10 && std::memcmp(tag, "ID3", 3) == 0) {
+        audioStart_ = 10 + ((tag[6] << 21) | (tag[7] << 14) | (tag[8] << 7) | tag[9]);
+        if (tag[5] & 0x10) audioStart_ += 10; // footer
+    }
+    SDL_RWseek(source_, audioStart_, RW_SEEK_SET);
+
+    std::vector<Uint8> first;
+    FrameInfo info;
+    if (!readFrame(first, info)) return false;
+    sampleRate_ = info.sampleRate;
+    samplesPerFrame_ = info.samplesPerFrame;
+
+    // a xing/info frame up front only carries metadata, start playback after it
+    std::string head(reinterpret_cast<const char*>(first.data()), std::min<size_t>(first.size(), 64));
+    if (head.find("Xing") != std::string::npos || head.find("Info") != std::string::npos) {
+        audioStart_ = SDL_RWtell(source_);
+    }
+    SDL_RWseek(source_, audioStart_, RW_SEEK_SET);
+
+    Uint16 format;
+    int channels;
+    if (!Mix_QuerySpec(&deviceFrequency_, &format, &channels)) return false;
+    deviceFrameBytes_ = SDL_AUDIO_BITSIZE(format) / 8 * channels;
+
+    // fixed ceiling for decoded audio, rounded up to a power of two for cheap wrapping
+    size_t wanted = static_cast<size_t>(deviceFrequency_) * deviceFrameBytes_ * bufferMs / 1000;
+    size_t capacity = 1;
+    while (capacity < wanted) capacity <<= 1;
+    ring_.assign(capacity, 0);
+    ringMask_ = capacity - 1;
+    return true;
+}
+
+Mix_Chunk* MusicStream::decodeSegment(size_t& skipBytes) {
+    // keep the tail of the last run as pre-roll for this one
+    size_t keepFrames = std::min<size_t>(PRE_ROLL_FRAMES, frameSizes_.size());
+    size_t keepBytes = 0;
+    for (size_t i = frameSizes_.size() - keepFrames; i < frameSizes_.size(); ++i) {
+        keepBytes += frameSizes_[i];
+    }
+    segment_.erase(segment_.begin(), segment_.end() - keepBytes);
+    frameSizes_.erase(frameSizes_.begin(), frameSizes_.end() - keepFrames);
+
+    FrameInfo info;
+    int newFrames = 0;
+    while (newFrames < SEGMENT_FRAMES) {
+        size_t before = segment_.size();
+        if (!readFrame(segment_, info)) {
+            if (newFrames > 0) break; // short last run, the next call loops
+            // end of the song, loop. the old pre-roll belongs to the end, not the start
+            SDL_RWseek(source_, audioStart_, RW_SEEK_SET);
+            segment_.clear();
+            frameSizes_.clear();
+            keepFrames = 0;
+            continue;
+        }
+        frameSizes_.push_back(segment_.size() - before);
+        ++newFrames;
+    }
+
+    Mix_Chunk* chunk = Mix_LoadWAV_RW(SDL_RWFromConstMem(segment_.data(), static_cast<int>(segment_.size())), 1);
+    if (!chunk) return nullptr;
+
+    // the pre-roll frames come out first, but how much they come out as is up
+    // to the decoder: the first one has no bit reservoir behind it and minimp3
+    // gives no samples at all for it. so they are decoded again on their own,
+    // from the same fresh state, and exactly that much is skipped
+    skipBytes = 0;
+    if (keepFrames > 0) {
+        size_t preRollBytes = 0;
+        for (size_t i = 0; i < keepFrames; ++i) {
+            preRollBytes += frameSizes_[i];
+        }
+        Mix_Chunk* preRoll = Mix_LoadWAV_RW(SDL_RWFromConstMem(segment_.data(), static_cast<int>(preRollBytes)), 1);
+        // no chunk means they decoded to nothing, so there is nothing to skip either
+        if (preRoll) {
+            skipBytes = std::min<size_t>(preRoll->alen, chunk->alen);
+            Mix_FreeChunk(preRoll);
+        }
+    }
+    return chunk;
+}
+
+size_t MusicStream::write(const Uint8* data, size_t length) {
+    size_t write = writeIndex_.load(std::memory_order_relaxed);
+    size_t read = readIndex_.load(std::memory_order_acquire);
+    size_t count = std::min(length, ring_.size() - (write - read));
+    count -= count % deviceFrameBytes_; // never split a sample frame
+
+    size_t at = write & ringMask_;
+    size_t first = std::min(count, ring_.size() - at);
+    std::memcpy(ring_.data() + at, data, first);
+    std::memcpy(ring_.data(), data + first, count - first);
+
+    writeIndex_.store(write + count, std::memory_order_release);
+    return count;
+}
+
+void MusicStream::decodeLoop(Mix_Chunk* chunk, size_t offset) {
+    Trace::setThreadName("music decoder");
+
+    while (running_) {
+        if (!chunk) {
+            TRACE_SCOPE("decode segment");
+            chunk = decodeSegment(offset);
+            if (!chunk) {
+                SDL_Delay(10); // broken run, try the next one shortly
+                continue;
+            }
+            ++segmentsDecoded_;
+        }
+
+        offset += write(chunk->abuf + offset, chunk->alen - offset);
+        if (offset >= chunk->alen) {
+            Mix_FreeChunk(chunk);
+            chunk = nullptr;
+        } else {
+            SDL_Delay(5); // ring is full, the callback drains it in real time
+        }
+    }
+
+    if (chunk) Mix_FreeChunk(chunk);
+}
+
+void MusicStream::mixCallback(void* userData, Uint8* stream, int length) {
+    // audio thread: copy what is there, silence for the rest, never wait
+    Trace::setThreadName("audio");
+    TRACE_SCOPE("music mix");
+    MusicStream* music = static_cast<MusicStream*>(userData);
+    size_t read = music->readIndex_.load(std::memory_order_relaxed);
+    size_t write = music->writeIndex_.load(std::memory_order_acquire);
+    size_t count = std::min(static_cast<size_t>(length), write - read);
+
+    size_t at = read & music->ringMask_;
+    size_t first = std::min(count, music->ring_.size() - at);
+    std::memcpy(stream, music->ring_.data() + at, first);
+    std::memcpy(stream + first, music->ring_.data(), count - first);
+    music->readIndex_.store(read + count, std::memory_order_release);
+
+    if (count < static_cast<size_t>(length)) {
+        std::memset(stream + count, 0, length - count); // silence for the signed formats the device uses
+        ++music->underruns_;
+    }
+}
+
+void MusicStream::play() {
+    if (running_ || ring_.empty()) return;
+
+    // the first run is decoded right here, on the thread that opened the mixer.
+    // SDL_mixer sets its mp3 decoder up on first use and that isnt thread safe,
+    // after this the decoder thread is the only one decoding mp3s. it also
+    // puts half a second in the ring before the callback is hooked, without
+    // waiting on the decoder thread to get ahead
+    size_t offset = 0;
+    Mix_Chunk* chunk = decodeSegment(offset);
+    if (chunk) {
+        ++segmentsDecoded_;
+        offset += write(chunk->abuf + offset, chunk->alen - offset);
+        if (offset >= chunk->alen) {
+            Mix_FreeChunk(chunk);
+            chunk = nullptr;
+            offset = 0;
+        }
+    }
+
+    running_ = true;
+    decoder_ = std::thread(&MusicStream::decodeLoop, this, chunk, offset);
+
+    // anything the ring is short of from here is silence, counted as an underrun
+    Mix_HookMusic(mixCallback, this);
+    hooked_ = true;
+}
+
+void MusicStream::stop() {
+    if (hooked_) {
+        Mix_HookMusic(nullptr, nullptr); // returns once the callback is out of the way
+        hooked_ = false;
+    }
+    if (running_) {
+        running_ = false;
+        decoder_.join();
+    }
+}
+
+MusicStreamStats MusicStream::getStats() const {
+    MusicStreamStats stats;
+    stats.underruns = underruns_.load();
+    stats.segmentsDecoded = segmentsDecoded_.load();
+    stats.bufferBytes = ring_.size();
+    stats.bufferedBytes = writeIndex_.load() - readIndex_.load();
+    return stats;
+}
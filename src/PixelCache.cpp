@@ -0,0 +1,159 @@
+#include "../headers/PixelCache.h"
+#include "../headers/AssetIO.h"
+#include "../headers/GameConstants.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// bump VERSION when the entry layout changes:
+//   magic[8] version:u32 mipLevels:u32 sourceSize:u64 sourceModified:i64
+//   pathLength:u32 path[pathLength] levelCount:u32
+//   levelCount x { width:u32 height:u32 pixels[width * height * 4] }
+const char MAGIC[8] = {'R', 'K', 'P', 'X', 'C', 'A', 'C', 'H'};
+const uint32_t VERSION = 1;
+
+// entries are only read back on the machine that wrote them, native byte order is fine
+template <typename T>
+void writeValue(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+// fnv-1a, only used to turn a path into a file name
+uint64_t hashPath(const std::string& path) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : path) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+void freeLevels(std::vector<SDL_Surface*>& levels) {
+    for (SDL_Surface* surface : levels) {
+        SDL_FreeSurface(surface);
+    }
+    levels.clear();
+}
+
+}
+
+std::string PixelCache::entryPath(const std::string& sourcePath) {
+    std::ostringstream name;
+    name << GameConstants::PIXEL_CACHE_DIR << "/" << std::hex << hashPath(sourcePath) << ".rgba";
+    return name.str();
+}
+
+bool PixelCache::load(const std::string& sourcePath, std::vector<SDL_Surface*>& levels) {
+    uint64_t sourceSize;
+    int64_t sourceModified;
+    if (!AssetIO::getFileInfo(sourcePath, sourceSize, sourceModified)) return false;
+
+    std::ifstream in(entryPath(sourcePath), std::ios::binary);
+    if (!in) return false;
+
+    // header has to match exactly, anything else is stale
+    char magic[8];
+    uint32_t version, mipLevels, pathLength, levelCount;
+    uint64_t size;
+    int64_t modified;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) return false;
+    if (!readValue(in, version) || version != VERSION) return false;
+    if (!readValue(in, mipLevels) || mipLevels != static_cast<uint32_t>(GameConstants::TEXTURE_MIP_LEVELS)) return false;
+    if (!readValue(in, size) || size != sourceSize) return false;
+    if (!readValue(in, modified) || modified != sourceModified) return false;
+    if (!readValue(in, pathLength) || pathLength != sourcePath.size()) return false;
+
+    std::string path(pathLength, '\0');
+    if (!in.read(&path[0], pathLength) || path != sourcePath) return false; // hash collision
+    if (!readValue(in, levelCount) || levelCount == 0) return false;
+
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        uint32_t width, height;
+        if (!readValue(in, width) || !readValue(in, height) || width == 0 || height == 0 ||
+            width > 16384 || height > 16384) {
+            freeLevels(levels);
+            return false;
+        }
+
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!surface) {
+            freeLevels(levels);
+            return false;
+        }
+        levels.push_back(surface);
+
+        // straight into the surface, rows are tightly packed in the file
+        char* pixels = static_cast<char*>(surface->pixels);
+        bool ok = true;
+        if (surface->pitch == static_cast<int>(width * 4)) {
+            ok = static_cast<bool>(in.read(pixels, static_cast<std::streamsize>(width) * height * 4));
+        } else {
+            for (uint32_t row = 0; row < height && ok; ++row) {
+                ok = static_cast<bool>(in.read(pixels + row * surface->pitch, width * 4));
+            }
+        }
+        if (!ok) {
+            freeLevels(levels);
+            return false;
+        }
+    }
+    return true;
+}
+
+void PixelCache::store(const std::string& sourcePath, const std::vector<SDL_Surface*>& levels) {
+    uint64_t sourceSize;
+    int64_t sourceModified;
+    if (levels.empty() || !AssetIO::getFileInfo(sourcePath, sourceSize, sourceModified)) return;
+
+    std::error_code error;
+    std::filesystem::create_directories(GameConstants::PIXEL_CACHE_DIR, error);
+    if (error) return; // read only install or similar, just run without a cache
+
+    std::string path = entryPath(sourcePath);
+    std::ostringstream temp;
+    temp << path << ".tmp" << std::this_thread::get_id();
+
+    {
+        std::ofstream out(temp.str(), std::ios::binary | std::ios::trunc);
+        if (!out) return;
+
+        out.write(MAGIC, sizeof(MAGIC));
+        writeValue<uint32_t>(out, VERSION);
+        writeValue<uint32_t>(out, GameConstants::TEXTURE_MIP_LEVELS);
+        writeValue<uint64_t>(out, sourceSize);
+        writeValue<int64_t>(out, sourceModified);
+        writeValue<uint32_t>(out, static_cast<uint32_t>(sourcePath.size()));
+        out.write(sourcePath.data(), sourcePath.size());
+        writeValue<uint32_t>(out, static_cast<uint32_t>(levels.size()));
+
+        for (SDL_Surface* surface : levels) {
+            writeValue<uint32_t>(out, surface->w);
+            writeValue<uint32_t>(out, surface->h);
+            const char* pixels = static_cast<const char*>(surface->pixels);
+            for (int row = 0; row < surface->h; ++row) {
+                out.write(pixels + row * surface->pitch, surface->w * 4);
+            }
+        }
+
+        if (!out) {
+            std::cerr << "Failed to write pixel cache for " << sourcePath << std::endl;
+            out.close();
+            std::filesystem::remove(temp.str(), error);
+            return;
+        }
+    }
+
+    std::filesystem::rename(temp.str(), path, error);
+    if (error) std::filesystem::remove(temp.str(), error);
+}
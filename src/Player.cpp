@@ -1,54 +1,53 @@
 #include "../headers/Player.h"
-#include "../headers/Bullet.h"
-#include "../headers/Sound.h"
-#include <SDL2/SDL_image.h>
-#include <SDL2/SDL_mixer.h>
+#include "../headers/GameConstants.h"
 #include <cmath>
 #include <iostream>
 
 // define the scale[size of sprite] in the main.cpp constructor parameter
-Player::Player(SDL_Renderer* renderer, const std::string& path, int screenWidth, int screenHeight, float scale, Sounds* sounds)
-    : renderer_(renderer), texture_(nullptr), sounds_(sounds),
+Player::Player(SDL_Renderer* renderer, AssetManager* assets, int screenWidth, int screenHeight, float scale)
+    : renderer_(renderer),
       x_(screenWidth / 2.0f), y_(screenHeight / 2.0f),
+      prevX_(x_), prevY_(y_),
       speed_(300.0f), scale_(scale),
       screenWidth_(screenWidth), screenHeight_(screenHeight),
-      movingUp_(false), movingDown_(false), movingLeft_(false), movingRight_(false)
+      movingUp_(false), movingDown_(false), movingLeft_(false), movingRight_(false),
+      aimX_(0), aimY_(0)
 {
-    SDL_Surface* surface = IMG_Load(path.c_str());
-    if (!surface) {
-        std::cerr << "Failed to load player image: " << IMG_GetError() << std::endl;
+    bulletTexture_ = assets->getTexture(GameConstants::BULLET_TEXTURE_PATH);
+
+    texture_ = assets->getTexture(GameConstants::PLAYER_TEXTURE_PATH);
+    if (!texture_) {
+        std::cerr << "Failed to load player image" << std::endl;
+        w_ = h_ = 0;
         return;
     }
 
-    texture_ = SDL_CreateTextureFromSurface(renderer, surface);
-    w_ = static_cast<int>(surface->w * scale_);
-    h_ = static_cast<int>(surface->h * scale_);
-    SDL_FreeSurface(surface);
+    w_ = static_cast<int>(texture_->width * scale_);
+    h_ = static_cast<int>(texture_->height * scale_);
+    texture_ = AssetManager::levelFor(texture_, w_, h_);
 }
 
-Player::~Player() {
-    if (texture_) SDL_DestroyTexture(texture_);
+void Player::applyInput(const InputState& input) {
+    movingUp_ = input.up;
+    movingDown_ = input.down;
+    movingLeft_ = input.left;
+    movingRight_ = input.right;
+    aimX_ = input.mouseX;
+    aimY_ = input.mouseY;
 }
 
-void Player::handleEvent(const SDL_Event& e) {
-    if (e.type == SDL_KEYDOWN && !e.key.repeat) {
-        switch (e.key.keysym.sym) {
-            case SDLK_w: movingUp_ = true; break;
-            case SDLK_s: movingDown_ = true; break;
-            case SDLK_a: movingLeft_ = true; break;
-            case SDLK_d: movingRight_ = true; break;
-        }
-    } else if (e.type == SDL_KEYUP && !e.key.repeat) {
-        switch (e.key.keysym.sym) {
-            case SDLK_w: movingUp_ = false; break;
-            case SDLK_s: movingDown_ = false; break;
-            case SDLK_a: movingLeft_ = false; break;
-            case SDLK_d: movingRight_ = false; break;
-        }
-    }
+void Player::reset() {
+    x_ = screenWidth_ / 2.0f;
+    y_ = screenHeight_ / 2.0f;
+    prevX_ = x_;
+    prevY_ = y_;
+    movingUp_ = movingDown_ = movingLeft_ = movingRight_ = false;
 }
 
 void Player::update(float deltaTime) {
+    prevX_ = x_;
+    prevY_ = y_;
+
     float move = speed_ * deltaTime; // move pixels per second
 
     if (movingUp_)    y_ -= move;
@@ -64,10 +63,8 @@ void Player::update(float deltaTime) {
 }
 
 float Player::getAngleToMouse() const {
-    int mouseX, mouseY;
-    SDL_GetMouseState(&mouseX, &mouseY);
-    float dx = mouseX - (x_ + w_ / 2.0f);
-    float dy = mouseY - (y_ + h_ / 2.0f);
+    float dx = aimX_ - (x_ + w_ / 2.0f);
+    float dy = aimY_ - (y_ + h_ / 2.0f);
     return atan2f(dy, dx) * 180.0f / M_PI;
 }
 
@@ -81,23 +78,20 @@ SDL_Rect Player::getHitbox() const {
     };
 }
 
-void Player::shoot(std::vector<Bullet*>& bullets) {
+bool Player::shoot(EntityPool<Bullet>& bullets) {
     // spawn at player center
     float centerX = x_ + w_ / 2.0f;
     float centerY = y_ + h_ / 2.0f;
 
-    int mouseX, mouseY;
-    SDL_GetMouseState(&mouseX, &mouseY);
-
-    bullets.push_back(new Bullet(renderer_, "assets/bullet.png", centerX, centerY, (float)mouseX, (float)mouseY));
-    if (sounds_) sounds_->playGunSound();
+    if (!bulletTexture_) return false;
+    return bullets.spawn(bulletTexture_, centerX, centerY, (float)aimX_, (float)aimY_) != nullptr;
 }
 
-void Player::render() {
-    if (!texture_) return;
-
-    SDL_Rect dst { static_cast<int>(x_), static_cast<int>(y_), w_, h_ };
-    float angle = getAngleToMouse() + 90.0f;
+bool Player::getSprite(SpriteState& sprite) const {
+    if (!texture_) return false;
 
-    SDL_RenderCopyEx(renderer_, texture_, nullptr, &dst, angle, nullptr, SDL_FLIP_NONE);
+    sprite = SpriteState{texture_.get(), prevX_, prevY_, x_, y_,
+                         static_cast<float>(w_), static_cast<float>(h_),
+                         getAngleToMouse() + 90.0f};
+    return true;
 }
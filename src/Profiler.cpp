@@ -0,0 +1,102 @@
+#include "../headers/Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+std::atomic<bool> Profiler::enabled_{false};
+Uint64 Profiler::frameStart_ = 0;
+std::atomic<Uint64> Profiler::frameTicks_[Profiler::SCOPE_COUNT] = {};
+std::vector<float> Profiler::history_;
+int Profiler::frameCount_ = 0;
+std::vector<float> Profiler::sortScratch_;
+
+namespace {
+
+const char* SCOPE_NAMES[] = {
+    "frame", "events", "update", "spawn", "bullets", "asteroids",
+    "collisions", "background", "render", "present", "idle",
+};
+static_assert(sizeof(SCOPE_NAMES) / sizeof(SCOPE_NAMES[0]) == static_cast<size_t>(ProfileScope::Count),
+              "every ProfileScope needs a name");
+
+}
+
+void Profiler::setEnabled(bool enabled) {
+    // history is only allocated once somebody actually profiles
+    if (enabled && history_.empty()) {
+        history_.assign(static_cast<size_t>(HISTORY_FRAMES) * SCOPE_COUNT, 0.0f);
+        sortScratch_.reserve(HISTORY_FRAMES);
+    }
+    enabled_ = enabled;
+    frameStart_ = 0;
+}
+
+void Profiler::beginFrame() {
+    if (!enabled_) return;
+    for (auto& ticks : frameTicks_) {
+        ticks.store(0, std::memory_order_relaxed);
+    }
+    frameStart_ = SDL_GetPerformanceCounter();
+}
+
+void Profiler::endFrame() {
+    // enabled halfway through a frame, that one doesnt count
+    if (!enabled_ || frameStart_ == 0) return;
+    frameTicks_[static_cast<int>(ProfileScope::Frame)].store(SDL_GetPerformanceCounter() - frameStart_,
+                                                             std::memory_order_relaxed);
+
+    const float toMs = 1000.0f / SDL_GetPerformanceFrequency();
+    float* row = &history_[static_cast<size_t>(frameCount_ % HISTORY_FRAMES) * SCOPE_COUNT];
+    for (int i = 0; i < SCOPE_COUNT; ++i) {
+        row[i] = frameTicks_[i].load(std::memory_order_relaxed) * toMs;
+    }
+    ++frameCount_;
+}
+
+ProfileStats Profiler::getStats(ProfileScope scope) {
+    int frames = getFrameCount();
+    if (frames == 0) return ProfileStats{0.0f, 0.0f, 0.0f};
+
+    int column = static_cast<int>(scope);
+    sortScratch_.clear();
+    for (int f = 0; f < frames; ++f) {
+        sortScratch_.push_back(history_[static_cast<size_t>(f) * SCOPE_COUNT + column]);
+    }
+    int newest = (frameCount_ - 1) % HISTORY_FRAMES;
+    float last = sortScratch_[newest];
+
+    std::sort(sortScratch_.begin(), sortScratch_.end());
+    float p50 = sortScratch_[(frames - 1) * 50 / 100];
+    float p99 = sortScratch_[(frames - 1) * 99 / 100];
+    return ProfileStats{last, p50, p99};
+}
+
+const char* Profiler::getName(ProfileScope scope) {
+    return SCOPE_NAMES[static_cast<int>(scope)];
+}
+
+bool Profiler::writeCsv(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to write profile " << path << std::endl;
+        return false;
+    }
+
+    out << "frame";
+    for (int i = 0; i < SCOPE_COUNT; ++i) {
+        out << "," << SCOPE_NAMES[i] << "_ms";
+    }
+    out << "\n";
+
+    int frames = getFrameCount();
+    int first = frameCount_ - frames;
+    for (int f = first; f < frameCount_; ++f) {
+        const float* row = &history_[static_cast<size_t>(f % HISTORY_FRAMES) * SCOPE_COUNT];
+        out << f;
+        for (int i = 0; i < SCOPE_COUNT; ++i) {
+            out << "," << row[i];
+        }
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,65 @@
+#include "../headers/ProfilerOverlay.h"
+#include "../headers/UIRenderer.h"
+#include "../headers/GameConstants.h"
+#include <cstdio>
+
+namespace {
+
+const int PANEL_WIDTH = 330;
+const int LINE_HEIGHT = 18;
+const int MARGIN = 10;
+
+}
+
+ProfilerOverlay::ProfilerOverlay(SDL_Renderer* renderer, int screenWidth)
+    : renderer_(renderer), screenWidth_(screenWidth), visible_(false), framesUntilRefresh_(0) {
+}
+
+ProfilerOverlay::~ProfilerOverlay() = default;
+
+void ProfilerOverlay::toggle() {
+    visible_ = !visible_;
+    if (!visible_) return;
+
+    Profiler::setEnabled(true);
+    if (!ui_) {
+        ui_.reset(new UIRenderer(renderer_, GameConstants::FONT_PATH, GameConstants::PROFILER_FONT_SIZE));
+    }
+    framesUntilRefresh_ = 0;
+}
+
+void ProfilerOverlay::refresh() {
+    char line[96];
+    std::snprintf(line, sizeof(line), "%-11s %7s %7s %7s", "ms", "last", "p50", "p99");
+    lines_[0] = line;
+
+    for (int i = 0; i < SCOPE_COUNT; ++i) {
+        ProfileScope scope = static_cast<ProfileScope>(i);
+        ProfileStats stats = Profiler::getStats(scope);
+        std::snprintf(line, sizeof(line), "%-11s %7.2f %7.2f %7.2f",
+                      Profiler::getName(scope), stats.lastMs, stats.p50Ms, stats.p99Ms);
+        lines_[i + 1] = line;
+    }
+}
+
+void ProfilerOverlay::render() {
+    if (!visible_ || !ui_ || !ui_->isInitialized()) return;
+
+    if (--framesUntilRefresh_ <= 0) {
+        refresh();
+        framesUntilRefresh_ = REFRESH_FRAMES;
+    }
+
+    // dark panel so the numbers stay readable over the background
+    SDL_Rect panel{screenWidth_ - PANEL_WIDTH - MARGIN, MARGIN,
+                   PANEL_WIDTH, (SCOPE_COUNT + 1) * LINE_HEIGHT + MARGIN};
+    SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 170);
+    SDL_RenderFillRect(renderer_, &panel);
+
+    // numbers change every refresh, glyph atlas path so they dont churn the text cache
+    SDL_Color white = {255, 255, 255, 255};
+    for (int i = 0; i <= SCOPE_COUNT; ++i) {
+        ui_->renderTextDynamic(lines_[i], panel.x + MARGIN / 2, panel.y + MARGIN / 2 + i * LINE_HEIGHT, 0, white);
+    }
+}
@@ -2,12 +2,23 @@
 #include <iostream>
 
 bool SDLManager::initialized_ = false;
+bool SDLManager::headless_ = false;
 
-bool SDLManager::initialize() {
+bool SDLManager::initialize(bool headless) {
     if (initialized_) {
         return true; 
     }
 
+    if (headless) {
+        if (SDL_Init(SDL_INIT_TIMER) < 0) {
+            std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        initialized_ = true;
+        headless_ = true;
+        return true;
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
@@ -35,9 +46,12 @@ void SDLManager::cleanup() {
         return;
     }
 
-    TTF_Quit();
-    IMG_Quit();
+    if (!headless_) {
+        TTF_Quit();
+        IMG_Quit();
+    }
     SDL_Quit();
     
     initialized_ = false;
+    headless_ = false;
 }
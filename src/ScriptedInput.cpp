@@ -0,0 +1,47 @@
+#include "../headers/ScriptedInput.h"
+#include <cmath>
+
+namespace {
+
+// WASD per phase, the player ends up roughly where it started after a full cycle
+struct MovePhase {
+    bool up, down, left, right;
+};
+
+constexpr MovePhase MOVE_PATTERN[] = {
+    {true,  false, false, false},
+    {false, false, false, true },
+    {false, true,  false, false},
+    {false, false, true,  false},
+    {false, false, false, false},
+    {true,  false, true,  false},
+    {false, true,  false, true },
+    {false, false, false, false},
+};
+
+constexpr int MOVE_PHASES = sizeof(MOVE_PATTERN) / sizeof(MOVE_PATTERN[0]);
+
+}
+
+ScriptedInput::ScriptedInput(int screenWidth, int screenHeight)
+    : screenWidth_(screenWidth), screenHeight_(screenHeight), tick_(0) {
+}
+
+InputState ScriptedInput::next() {
+    InputState input;
+
+    const MovePhase& phase = MOVE_PATTERN[(tick_ / TICKS_PER_MOVE) % MOVE_PHASES];
+    input.up = phase.up;
+    input.down = phase.down;
+    input.left = phase.left;
+    input.right = phase.right;
+
+    float aim = tick_ * AIM_TURN_PER_TICK;
+    input.mouseX = static_cast<int>(screenWidth_ / 2.0f + std::cos(aim) * AIM_RADIUS);
+    input.mouseY = static_cast<int>(screenHeight_ / 2.0f + std::sin(aim) * AIM_RADIUS);
+
+    if (tick_ % TICKS_PER_SHOT == 0) input.shots = 1;
+
+    ++tick_;
+    return input;
+}
@@ -0,0 +1,90 @@
+#include "../headers/SimulationThread.h"
+#include "../headers/Game.h"
+#include "../headers/GameConstants.h"
+#include "../headers/Trace.h"
+#include <algorithm>
+#include <chrono>
+
+SimulationThread::SimulationThread(Game& game, int tickRate, int maxStepsPerFrame)
+    : game_(game),
+      timestep_(tickRate, maxStepsPerFrame),
+      counterToSeconds_(1.0 / SDL_GetPerformanceFrequency()),
+      running_(false), finished_(false), ticks_(0) {
+    // room for every entity the pools can hold, so capturing never allocates
+    for (int i = 0; i < 3; ++i) {
+        snapshots_.slot(i).sprites.reserve(GameConstants::MAX_ASTEROIDS + GameConstants::MAX_BULLETS + 1);
+    }
+}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start() {
+    if (running_) return;
+
+    // the start screen could have been up for minutes, none of that is owed as ticks
+    timestep_.reset();
+    finished_ = false;
+    running_ = true;
+    thread_ = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+    running_ = false;
+    if (thread_.joinable()) thread_.join();
+}
+
+const GameSnapshot& SimulationThread::acquireSnapshot() {
+    snapshots_.acquire();
+    return snapshots_.front();
+}
+
+float SimulationThread::getAlpha(const GameSnapshot& snapshot) const {
+    if (snapshot.tick == 0) return 1.0f;
+    double since = (SDL_GetPerformanceCounter() - snapshot.tickCounter) * counterToSeconds_;
+    return std::min(1.0f, std::max(0.0f, static_cast<float>(since / timestep_.getStepSeconds())));
+}
+
+void SimulationThread::run() {
+    Trace::setThreadName("simulation");
+
+    while (running_) {
+        // sleep right up to the tick, only the last sliver is yielded away.
+        // waking a little late is fine, interpolation hides sub ms tick jitter
+        double wait = timestep_.getSecondsUntilNextStep();
+        if (wait > 0.0) {
+            double spin = GameConstants::SIMULATION_SPIN_US / 1e6;
+            if (wait > spin) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(wait - spin));
+            } else {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+
+        int steps = timestep_.advance();
+        if (steps == 0) continue;
+
+        bool alive = true;
+        {
+            TRACE_SCOPE("simulate");
+            for (int i = 0; i < steps && alive; ++i) {
+                alive = game_.update(timestep_.getStepSeconds());
+            }
+            game_.flushAudio();
+        }
+
+        // the back slot is never the one the main thread is drawing, no lock needed
+        GameSnapshot& snapshot = snapshots_.back();
+        game_.captureSnapshot(snapshot);
+        snapshot.tick = ticks_.fetch_add(steps, std::memory_order_relaxed) + steps;
+        snapshot.tickCounter = SDL_GetPerformanceCounter();
+        snapshots_.publish();
+
+        if (!alive) {
+            finished_.store(true, std::memory_order_release);
+            break;
+        }
+    }
+}
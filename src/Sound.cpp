@@ -1,22 +1,110 @@
 #include "../headers/Sound.h"
+#include "../headers/AssetIO.h"
+#include "../headers/GameConstants.h"
+#include "../headers/Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 
+namespace {
+
+// all sound effect voices share this mixer group, so stealing never touches anything else
+const int EFFECT_GROUP = 1;
+
+// how loud one trigger of each effect plays, merged triggers add VOLUME_PER_MERGE each
+const int SHOT_VOLUME = 80;
+const int IMPACT_VOLUME = 72;
+const int DEATH_VOLUME = MIX_MAX_VOLUME;
+const int VOLUME_PER_MERGE = 12;
+
+// Mix_SetPosition distance for something a full screen diagonal away.
+// 255 is close to silent, this keeps far hits quieter but still there
+const int MAX_EFFECT_DISTANCE = 160;
+
+}
+
+AudioConfig AudioConfig::lowLatency() {
+    AudioConfig config;
+    config.bufferSamples = 256; // ~6 ms at 44.1 kHz instead of ~46
+    config.voices = 16;         // enough for overlapping rapid fire without stealing every shot
+    return config;
+}
+
 Sounds::~Sounds() {
+    musicStream.reset(); // unhooks from the mixer before the device goes away
     if (gunSound) Mix_FreeChunk(gunSound);
+    if (impactSound) Mix_FreeChunk(impactSound);
+    if (deathSound) Mix_FreeChunk(deathSound);
     if (bgMusic) Mix_FreeMusic(bgMusic);
     Mix_CloseAudio();
 }
 
-bool Sounds::init() {
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+bool Sounds::init(const AudioConfig& audioConfig) {
+    config = audioConfig;
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, config.bufferSamples) < 0) {
         std::cerr << "SDL_mixer could not initialize! " << Mix_GetError() << std::endl;
         return false;
     }
+
+    // the device can differ from what was asked for, chunks get converted to this at load
+    Mix_QuerySpec(&deviceFrequency, &deviceFormat, &deviceChannels);
+
+    config.voices = Mix_AllocateChannels(config.voices);
+    Mix_GroupChannels(0, config.voices - 1, EFFECT_GROUP);
+
+    triggerCounters.reset(new std::atomic<Uint64>[config.voices]);
+    for (int i = 0; i < config.voices; ++i) {
+        triggerCounters[i] = 0;
+    }
+
+    // short bright crack for hits, long dull rumble for the player going down
+    impactSound = makeNoiseBurst(impactSamples, 120, 25.0f, 0.35f);
+    deathSound = makeNoiseBurst(deathSamples, 900, 250.0f, 0.08f);
     return true;
 }
 
+Mix_Chunk* Sounds::makeNoiseBurst(std::vector<Uint8>& samples, int lengthMs, float decayMs, float smoothing) {
+    // written straight in the device format so the mixer never converts it
+    if (deviceFormat != AUDIO_S16SYS && deviceFormat != AUDIO_F32SYS) return nullptr;
+    int sampleBytes = SDL_AUDIO_BITSIZE(deviceFormat) / 8;
+    int frames = deviceFrequency * lengthMs / 1000;
+    samples.assign(static_cast<size_t>(frames) * deviceChannels * sampleBytes, 0);
+
+    // white noise through a one pole low pass (smaller smoothing = duller),
+    // fading out exponentially. fixed seed so it sounds the same every run
+    Uint32 noise = 0x9E3779B9u;
+    float filtered = 0.0f;
+    float decayFrames = decayMs * deviceFrequency / 1000.0f;
+    Uint8* out = samples.data();
+    for (int i = 0; i < frames; ++i) {
+        noise = noise * 1664525u + 1013904223u;
+        float white = static_cast<float>(noise >> 8) / 8388608.0f - 1.0f;
+        filtered += (white - filtered) * smoothing;
+        float value = filtered * std::exp(-i / decayFrames);
+
+        for (int c = 0; c < deviceChannels; ++c, out += sampleBytes) {
+            if (deviceFormat == AUDIO_S16SYS) {
+                Sint16 sample = static_cast<Sint16>(std::max(-1.0f, std::min(1.0f, value)) * 32767.0f);
+                std::memcpy(out, &sample, sizeof(sample));
+            } else {
+                std::memcpy(out, &value, sizeof(value));
+            }
+        }
+    }
+    return Mix_QuickLoad_RAW(samples.data(), static_cast<Uint32>(samples.size()));
+}
+
 bool Sounds::loadMusic(const std::string& path) {
-    bgMusic = Mix_LoadMUS(path.c_str());
+    // decoded piece by piece on its own thread with a fixed buffer, see MusicStream
+    std::unique_ptr<MusicStream> stream(new MusicStream());
+    if (stream->open(path, GameConstants::MUSIC_STREAM_BUFFER_MS)) {
+        musicStream = std::move(stream);
+        return true;
+    }
+
+    // not an mp3 MusicStream can split, let SDL_mixer play it the usual way
+    bgMusic = Mix_LoadMUS_RW(AssetIO::open(path), 1);
     if (!bgMusic) {
         std::cerr << "Failed to load music: " << Mix_GetError() << std::endl;
         return false;
@@ -25,18 +113,149 @@ bool Sounds::loadMusic(const std::string& path) {
 }
 
 bool Sounds::loadGunSound(const std::string& path) {
-    gunSound = Mix_LoadWAV(path.c_str());
+    // fully decoded and converted to the device format here, playing it is just a copy
+    gunSound = Mix_LoadWAV_RW(AssetIO::open(path), 1);
     if (!gunSound) {
         std::cerr << "Failed to load gun sound: " << Mix_GetError() << std::endl;
         return false;
     }
+    trimLeadingSilence(gunSound);
     return true;
 }
 
+void Sounds::trimLeadingSilence(Mix_Chunk* chunk) {
+    // mp3 encoders pad the start with silence (often 20+ ms), which is pure
+    // latency for a gunshot. drop whole frames until something is audible
+    int sampleBytes = SDL_AUDIO_BITSIZE(deviceFormat) / 8;
+    int frameBytes = sampleBytes * deviceChannels;
+    if (frameBytes == 0 || deviceFrequency == 0) return;
+
+    Uint32 frames = chunk->alen / frameBytes;
+    Uint32 first = 0;
+    for (; first < frames; ++first) {
+        const Uint8* frame = chunk->abuf + first * frameBytes;
+        bool audible = false;
+        for (int c = 0; c < deviceChannels && !audible; ++c) {
+            if (deviceFormat == AUDIO_S16SYS) {
+                Sint16 sample;
+                std::memcpy(&sample, frame + c * sampleBytes, sizeof(sample));
+                audible = sample > 128 || sample < -128; // about -48 dB
+            } else if (deviceFormat == AUDIO_F32SYS) {
+                float sample;
+                std::memcpy(&sample, frame + c * sampleBytes, sizeof(sample));
+                audible = sample > 0.004f || sample < -0.004f;
+            } else {
+                return; // unusual device format, leave the chunk alone
+            }
+        }
+        if (audible) break;
+    }
+    if (first == 0 || first == frames) return;
+
+    Uint32 cut = first * frameBytes;
+    std::memmove(chunk->abuf, chunk->abuf + cut, chunk->alen - cut);
+    chunk->alen -= cut;
+    trimmedMs = first * 1000.0 / deviceFrequency;
+}
+
 void Sounds::playMusic() {
-    if (bgMusic) Mix_PlayMusic(bgMusic, -1);
+    if (musicStream) {
+        musicStream->play();
+    } else if (bgMusic) {
+        Mix_PlayMusic(bgMusic, -1);
+    }
+}
+
+MusicStreamStats Sounds::getMusicStats() const {
+    if (musicStream) return musicStream->getStats();
+    return MusicStreamStats{0, 0, 0, 0};
+}
+
+Mix_Chunk* Sounds::chunkFor(SoundEffect effect) const {
+    switch (effect) {
+        case SoundEffect::Shot: return gunSound;
+        case SoundEffect::Impact: return impactSound;
+        case SoundEffect::Death: return deathSound;
+    }
+    return nullptr;
+}
+
+void Sounds::playEvents(const AudioEventQueue& events, int screenWidth, int screenHeight) {
+    TRACE_SCOPE("play sounds");
+    float halfWidth = screenWidth / 2.0f;
+    float diagonal = std::sqrt(static_cast<float>(screenWidth * screenWidth + screenHeight * screenHeight));
+
+    for (const AudioEvent& event : events.getEvents()) {
+        Mix_Chunk* chunk = chunkFor(event.effect);
+        if (!chunk) continue;
+
+        float dx = event.x - events.getListenerX();
+        float dy = event.y - events.getListenerY();
+
+        // left/right only, stereo has nothing to say about up and down.
+        // 0 is straight ahead, 90 hard right, 270 hard left
+        float pan = std::max(-1.0f, std::min(1.0f, dx / halfWidth));
+        Sint16 angle = static_cast<Sint16>(pan * 90.0f);
+        if (angle < 0) angle += 360;
+        float far = std::min(1.0f, std::sqrt(dx * dx + dy * dy) / diagonal);
+        Uint8 distance = static_cast<Uint8>(far * MAX_EFFECT_DISTANCE);
+
+        int volume = event.effect == SoundEffect::Shot   ? SHOT_VOLUME
+                   : event.effect == SoundEffect::Impact ? IMPACT_VOLUME
+                                                         : DEATH_VOLUME;
+        volume = std::min(MIX_MAX_VOLUME, volume + (event.count - 1) * VOLUME_PER_MERGE);
+
+        playEffect(chunk, volume, angle, distance);
+    }
+}
+
+int Sounds::playEffect(Mix_Chunk* chunk, int volume, Sint16 angle, Uint8 distance) {
+    // free voice if there is one, otherwise cut off the effect that has played longest
+    int channel = Mix_GroupAvailable(EFFECT_GROUP);
+    if (channel == -1) {
+        channel = Mix_GroupOldest(EFFECT_GROUP);
+        if (channel == -1) return -1;
+        Mix_HaltChannel(channel);
+        ++stolenVoices;
+    }
+
+    // effects are registered before playing so the mixer can't get to the chunk first,
+    // finishing or halting the channel unregisters them again
+    triggerCounters[channel] = SDL_GetPerformanceCounter();
+    Mix_RegisterEffect(channel, measureEffect, nullptr, this);
+    Mix_SetPosition(channel, angle, distance);
+    Mix_Volume(channel, volume);
+    if (Mix_PlayChannel(channel, chunk, 0) == -1) {
+        triggerCounters[channel] = 0;
+        return -1;
+    }
+    return channel;
+}
+
+void Sounds::measureEffect(int channel, void*, int, void* userData) {
+    // runs on the audio thread for every buffer the channel is mixed into, only the first one counts
+    Sounds* sounds = static_cast<Sounds*>(userData);
+    Uint64 trigger = sounds->triggerCounters[channel].exchange(0);
+    if (trigger == 0) return;
+
+    Uint64 elapsed = SDL_GetPerformanceCounter() - trigger;
+    sounds->latencySamples.fetch_add(1);
+    sounds->latencyTotal.fetch_add(elapsed);
+    Uint64 worst = sounds->latencyWorst.load();
+    while (elapsed > worst && !sounds->latencyWorst.compare_exchange_weak(worst, elapsed)) {
+    }
 }
 
-void Sounds::playGunSound() {
-    if (gunSound) Mix_PlayChannel(-1, gunSound, 0);
+AudioLatencyStats Sounds::getLatencyStats() const {
+    double toMs = 1000.0 / SDL_GetPerformanceFrequency();
+    double bufferMs = deviceFrequency ? config.bufferSamples * 1000.0 / deviceFrequency : 0.0;
+
+    AudioLatencyStats stats;
+    stats.samples = latencySamples.load();
+    stats.averageMs = stats.samples ? latencyTotal.load() * toMs / stats.samples + bufferMs : 0.0;
+    stats.worstMs = stats.samples ? latencyWorst.load() * toMs + bufferMs : 0.0;
+    stats.bufferMs = bufferMs;
+    stats.trimmedMs = trimmedMs;
+    stats.stolenVoices = stolenVoices;
+    return stats;
 }
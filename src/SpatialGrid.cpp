@@ -0,0 +1,56 @@
+#include "../headers/SpatialGrid.h"
+#include "../headers/AsteroidField.h"
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(int width, int height, int cellSize)
+    : cellSize_(cellSize),
+      cols_((width + cellSize - 1) / cellSize),
+      rows_((height + cellSize - 1) / cellSize) {
+    cellStart_.resize(cols_ * rows_ + 1, 0);
+    cellCursor_.resize(cols_ * rows_, 0);
+}
+
+bool SpatialGrid::cellRange(const SDL_Rect& rect, int& x0, int& y0, int& x1, int& y1) const {
+    if (rect.w <= 0 || rect.h <= 0) return false;
+
+    // clamping keeps overlapping rects in overlapping cells, even off screen
+    x0 = std::clamp(rect.x / cellSize_, 0, cols_ - 1);
+    y0 = std::clamp(rect.y / cellSize_, 0, rows_ - 1);
+    x1 = std::clamp((rect.x + rect.w - 1) / cellSize_, 0, cols_ - 1);
+    y1 = std::clamp((rect.y + rect.h - 1) / cellSize_, 0, rows_ - 1);
+    return true;
+}
+
+void SpatialGrid::rebuild(const AsteroidField& asteroids) {
+    std::fill(cellStart_.begin(), cellStart_.end(), 0);
+
+    // pass 1: count how many asteroids land in each cell
+    int x0, y0, x1, y1;
+    for (size_t i = 0; i < asteroids.size(); ++i) {
+        if (!cellRange(asteroids.getRect(i), x0, y0, x1, y1)) continue;
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                ++cellStart_[cy * cols_ + cx + 1];
+            }
+        }
+    }
+
+    // prefix sum turns counts into start offsets
+    for (size_t c = 1; c < cellStart_.size(); ++c) {
+        cellStart_[c] += cellStart_[c - 1];
+    }
+    std::copy(cellStart_.begin(), cellStart_.end() - 1, cellCursor_.begin());
+
+    // only grows past the busiest tick so far, after that this never allocates
+    entries_.resize(cellStart_.back());
+
+    // pass 2: fill, walking asteroids in order keeps each cell sorted by index
+    for (size_t i = 0; i < asteroids.size(); ++i) {
+        if (!cellRange(asteroids.getRect(i), x0, y0, x1, y1)) continue;
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                entries_[cellCursor_[cy * cols_ + cx]++] = static_cast<int>(i);
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#include "../headers/SpriteBatch.h"
+#include <cmath>
+
+SpriteBatch::SpriteBatch(SDL_Renderer* renderer)
+    : renderer_(renderer), runCount_(0), drawCalls_(0), spriteCount_(0) {
+}
+
+void SpriteBatch::begin() {
+    // runs and their buffers stick around between frames, only the contents go
+    for (size_t i = 0; i < runCount_; ++i) {
+        runs_[i].vertices.clear();
+        runs_[i].indices.clear();
+    }
+    runCount_ = 0;
+    spriteCount_ = 0;
+}
+
+SpriteBatch::Run& SpriteBatch::runFor(SDL_Texture* texture) {
+    // only ever appends to the last run, going back to an earlier one
+    // would draw this sprite under everything submitted since
+    if (runCount_ > 0 && runs_[runCount_ - 1].texture == texture) {
+        return runs_[runCount_ - 1];
+    }
+
+    if (runCount_ == runs_.size()) {
+        runs_.push_back(Run{texture, {}, {}});
+    }
+    Run& run = runs_[runCount_++];
+    run.texture = texture;
+    run.vertices.clear();
+    run.indices.clear();
+    return run;
+}
+
+void SpriteBatch::draw(const TextureAsset& texture, const SDL_FRect& dst, float angle) {
+    if (!texture.texture) return; // headless handle, nothing to draw
+
+    Run& run = runFor(texture.texture);
+
+    // corners relative to the middle of dst, rotated the way RenderCopyEx does it
+    float halfW = dst.w / 2.0f;
+    float halfH = dst.h / 2.0f;
+    float centerX = dst.x + halfW;
+    float centerY = dst.y + halfH;
+    float radians = angle * static_cast<float>(M_PI) / 180.0f;
+    float s = std::sin(radians);
+    float c = std::cos(radians);
+
+    // uvs of the source rect, the whole texture unless its an atlas region
+    float u0 = static_cast<float>(texture.source.x) / texture.textureWidth;
+    float v0 = static_cast<float>(texture.source.y) / texture.textureHeight;
+    float u1 = static_cast<float>(texture.source.x + texture.source.w) / texture.textureWidth;
+    float v1 = static_cast<float>(texture.source.y + texture.source.h) / texture.textureHeight;
+
+    const SDL_Color white = {255, 255, 255, 255};
+    const float corners[4][4] = {
+        // x offset, y offset, u, v
+        {-halfW, -halfH, u0, v0},
+        { halfW, -halfH, u1, v0},
+        { halfW,  halfH, u1, v1},
+        {-halfW,  halfH, u0, v1},
+    };
+
+    int first = static_cast<int>(run.vertices.size());
+    for (const auto& corner : corners) {
+        SDL_Vertex vertex;
+        vertex.position.x = corner[0] * c - corner[1] * s + centerX;
+        vertex.position.y = corner[0] * s + corner[1] * c + centerY;
+        vertex.color = white;
+        vertex.tex_coord.x = corner[2];
+        vertex.tex_coord.y = corner[3];
+        run.vertices.push_back(vertex);
+    }
+
+    int quad[6] = {first, first + 1, first + 2, first, first + 2, first + 3};
+    run.indices.insert(run.indices.end(), quad, quad + 6);
+    ++spriteCount_;
+}
+
+void SpriteBatch::flush() {
+    drawCalls_ = 0;
+    for (size_t i = 0; i < runCount_; ++i) {
+        Run& run = runs_[i];
+        if (run.indices.empty()) continue;
+
+        SDL_RenderGeometry(renderer_, run.texture,
+                           run.vertices.data(), static_cast<int>(run.vertices.size()),
+                           run.indices.data(), static_cast<int>(run.indices.size()));
+        ++drawCalls_;
+
+        run.vertices.clear();
+        run.indices.clear();
+    }
+    runCount_ = 0; // anything drawn after a flush starts fresh, on top
+}
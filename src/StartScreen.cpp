@@ -1,11 +1,12 @@
 #include "../headers/StartScreen.h"
 #include "../headers/GameConstants.h"
+#include "../headers/AssetIO.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
 
-StartScreen::StartScreen(SDL_Renderer* renderer, int screenWidth, int screenHeight)
-    : renderer_(renderer), playButtonTexture_(nullptr), playerTexture_(nullptr),
+StartScreen::StartScreen(SDL_Renderer* renderer, AssetManager* assets, int screenWidth, int screenHeight)
+    : renderer_(renderer), playButtonTexture_(nullptr),
       font_(nullptr), screenWidth_(screenWidth), screenHeight_(screenHeight),
       playerScale_(1.2f), mouseOverButton_(false), startGame_(false) {
     
@@ -14,13 +15,13 @@ StartScreen::StartScreen(SDL_Renderer* renderer, int screenWidth, int screenHeig
         return;
     }
     
-    font_ = TTF_OpenFont(GameConstants::FONT_PATH, 200);
+    font_ = TTF_OpenFontRW(AssetIO::open(GameConstants::FONT_PATH), 1, 200);
     if (!font_) {
         std::cerr << "Failed to load font: " << TTF_GetError() << std::endl;
         return;
     }
     
-    loadPlayerTexture();
+    loadPlayerTexture(assets);
     createPlayButton();
 }
 
@@ -28,9 +29,6 @@ StartScreen::~StartScreen() {
     if (playButtonTexture_) {
         SDL_DestroyTexture(playButtonTexture_);
     }
-    if (playerTexture_) {
-        SDL_DestroyTexture(playerTexture_);
-    }
     if (font_) {
         TTF_CloseFont(font_);
     }
@@ -67,33 +65,26 @@ void StartScreen::createPlayButton() {
     playButtonRect_.h = textHeight;
 }
 
-void StartScreen::loadPlayerTexture() {
-    SDL_Surface* surface = IMG_Load(GameConstants::PLAYER_TEXTURE_PATH);
-    if (!surface) {
-        std::cerr << "Failed to load player image: " << IMG_GetError() << std::endl;
-        return;
-    }
-
-    playerTexture_ = SDL_CreateTextureFromSurface(renderer_, surface);
+void StartScreen::loadPlayerTexture(AssetManager* assets) {
+    playerTexture_ = assets->getTexture(GameConstants::PLAYER_TEXTURE_PATH);
     if (!playerTexture_) {
-        std::cerr << "Failed to create player texture: " << SDL_GetError() << std::endl;
-        SDL_FreeSurface(surface);
+        std::cerr << "Failed to load player image" << std::endl;
         return;
     }
 
     int leftSectionWidth = screenWidth_ / 2; 
     int leftSectionHeight = screenHeight_;
     
-    float maxWidthScale = (leftSectionWidth * 0.9f) / surface->w;
-    float maxHeightScale = (leftSectionHeight * 0.9f) / surface->h;
+    float maxWidthScale = (leftSectionWidth * 0.9f) / playerTexture_->width;
+    float maxHeightScale = (leftSectionHeight * 0.9f) / playerTexture_->height;
     float fitScale = std::min(maxWidthScale, maxHeightScale);
     
     // Use the larger of fitScale or playerScale_
     float finalScale = std::max(playerScale_, fitScale);
     
-    playerWidth_ = static_cast<int>(surface->w * finalScale);
-    playerHeight_ = static_cast<int>(surface->h * finalScale);
-    SDL_FreeSurface(surface);
+    playerWidth_ = static_cast<int>(playerTexture_->width * finalScale);
+    playerHeight_ = static_cast<int>(playerTexture_->height * finalScale);
+    playerTexture_ = AssetManager::levelFor(playerTexture_, playerWidth_, playerHeight_);
 
     // player position
     int playerMargin = (leftSectionWidth - playerWidth_) / 2; 
@@ -131,9 +122,9 @@ void StartScreen::handleEvent(const SDL_Event& e) {
 
 void StartScreen::render() {
     // player sprite rotated toward mouse
-    if (playerTexture_) {
+    if (playerTexture_ && playerTexture_->texture) {
         float angle = getAngleToMouse();
-        SDL_RenderCopyEx(renderer_, playerTexture_, nullptr, &playerRect_,
+        SDL_RenderCopyEx(renderer_, playerTexture_->texture, &playerTexture_->source, &playerRect_,
                         angle, nullptr, SDL_FLIP_NONE);
     }
     
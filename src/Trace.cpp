@@ -0,0 +1,264 @@
+#include "../headers/Trace.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+std::atomic<bool> Trace::enabled_{false};
+
+namespace {
+
+struct Event {
+    const char* name;
+    Uint64 ticks;
+    char phase; // 'B' or 'E'
+};
+
+// events are appended in chunks so a long session never reallocates (and
+// never moves events a concurrent write() is reading). count and next are
+// published with release so the reader only sees finished events
+const size_t CHUNK_EVENTS = 4096;
+const size_t MAX_EVENTS_PER_THREAD = 1 << 21; // ~48 MB, later scopes are dropped
+const size_t POOL_CHUNKS = 32;                // spare chunks kept ready for the recording threads
+const int MAX_THREADS = 64;
+
+struct Chunk {
+    Event events[CHUNK_EVENTS];
+    std::atomic<size_t> count{0};
+    std::atomic<Chunk*> next{nullptr};
+};
+
+struct ThreadBuffer {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<Chunk*> first{nullptr};
+    Chunk* current = nullptr;   // owner thread only
+    size_t total = 0;           // owner thread only
+    size_t open = 0;            // recorded begins still waiting for their end, owner only
+    size_t droppedOpen = 0;     // dropped begins still waiting for their end, owner only
+    std::atomic<Uint64> dropped{0};
+
+    ~ThreadBuffer() {
+        Chunk* chunk = first.load();
+        while (chunk) {
+            Chunk* next = chunk->next.load();
+            delete chunk;
+            chunk = next;
+        }
+    }
+};
+
+// recording never allocates, the audio callback records too and must not
+// block in the allocator. the main thread fills empty slots in refill(),
+// recorders swap a full slot out, so each slot has one writer and the
+// exchange is all the synchronisation it needs
+struct ChunkPool {
+    std::atomic<Chunk*> slots[POOL_CHUNKS] = {};
+
+    ~ChunkPool() {
+        for (auto& slot : slots) delete slot.load();
+    }
+};
+
+ChunkPool pool;
+
+Chunk* takeChunk() {
+    for (auto& slot : pool.slots) {
+        if (slot.load(std::memory_order_relaxed)) {
+            Chunk* chunk = slot.exchange(nullptr, std::memory_order_acquire);
+            if (chunk) return chunk;
+        }
+    }
+    return nullptr;
+}
+
+// fixed slots so a thread registers with one fetch_add instead of a lock.
+// buffers outlive their threads so a worker that already exited still shows up
+ThreadBuffer buffers[MAX_THREADS];
+std::atomic<int> bufferCount{0};
+std::atomic<Uint64> unregisteredDropped{0}; // threads past MAX_THREADS
+std::atomic<Uint64> startTicks{0};
+thread_local ThreadBuffer* localBuffer = nullptr;
+thread_local bool localUnregistered = false;
+thread_local const char* localName = nullptr; // kept here until the thread records something
+
+ThreadBuffer* threadBuffer() {
+    if (!localBuffer && !localUnregistered) {
+        int index = bufferCount.fetch_add(1, std::memory_order_relaxed);
+        if (index < MAX_THREADS) {
+            localBuffer = &buffers[index];
+            localBuffer->name.store(localName, std::memory_order_relaxed);
+        } else {
+            localUnregistered = true;
+        }
+    }
+    return localBuffer;
+}
+
+int registeredThreads() {
+    return std::min(bufferCount.load(std::memory_order_relaxed), MAX_THREADS);
+}
+
+void append(ThreadBuffer* buffer, const char* name, char phase) {
+    Chunk* chunk = buffer->current;
+    size_t count = chunk->count.load(std::memory_order_relaxed);
+    chunk->events[count] = Event{name, SDL_GetPerformanceCounter(), phase};
+    chunk->count.store(count + 1, std::memory_order_release);
+    ++buffer->total;
+}
+
+void drop(ThreadBuffer* buffer) {
+    buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+// scopes nest per thread, so a begin only goes in if there is room for it,
+// its own end and the end of every scope still open. ends then always fit
+// and a full buffer never leaves a begin without its end. once a begin is
+// dropped everything inside it is dropped too, up to its end
+void recordBegin(ThreadBuffer* buffer, const char* name) {
+    bool room = buffer->droppedOpen == 0 && buffer->total + buffer->open + 2 <= MAX_EVENTS_PER_THREAD;
+
+    Chunk* chunk = buffer->current;
+    if (room && (!chunk || chunk->count.load(std::memory_order_relaxed) + buffer->open + 2 > CHUNK_EVENTS)) {
+        // the pool ran dry if the main thread has not refilled it in a while
+        Chunk* next = takeChunk();
+        if (next) {
+            if (chunk) {
+                chunk->next.store(next, std::memory_order_release);
+            } else {
+                buffer->first.store(next, std::memory_order_release);
+            }
+            buffer->current = next;
+        } else {
+            room = false;
+        }
+    }
+
+    if (!room) {
+        ++buffer->droppedOpen;
+        drop(buffer);
+        return;
+    }
+    ++buffer->open;
+    append(buffer, name, 'B');
+}
+
+void recordEnd(ThreadBuffer* buffer, const char* name) {
+    if (buffer->droppedOpen > 0) {
+        --buffer->droppedOpen;
+        drop(buffer);
+    } else if (buffer->open > 0) {
+        --buffer->open;
+        append(buffer, name, 'E');
+    } else {
+        drop(buffer); // no begin to match, nothing was reserved for it
+    }
+}
+
+}
+
+void Trace::setEnabled(bool enabled) {
+    if (enabled) {
+        Uint64 unset = 0;
+        startTicks.compare_exchange_strong(unset, SDL_GetPerformanceCounter());
+    }
+    enabled_.store(enabled, std::memory_order_relaxed);
+    refill();
+}
+
+void Trace::refill() {
+    if (!isEnabled()) return;
+    for (auto& slot : pool.slots) {
+        if (!slot.load(std::memory_order_relaxed)) {
+            slot.store(new Chunk(), std::memory_order_release);
+        }
+    }
+}
+
+void Trace::begin(const char* name) {
+    ThreadBuffer* buffer = threadBuffer();
+    if (buffer) {
+        recordBegin(buffer, name);
+    } else {
+        unregisteredDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Trace::end(const char* name) {
+    ThreadBuffer* buffer = threadBuffer();
+    if (buffer) {
+        recordEnd(buffer, name);
+    } else {
+        unregisteredDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Trace::setThreadName(const char* name) {
+    // no buffer yet if tracing is off, it picks the name up when it gets one
+    localName = name;
+    if (localBuffer) localBuffer->name.store(name, std::memory_order_relaxed);
+}
+
+size_t Trace::getEventCount() {
+    size_t total = 0;
+    for (int i = 0; i < registeredThreads(); ++i) {
+        for (Chunk* chunk = buffers[i].first.load(std::memory_order_acquire); chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            total += chunk->count.load(std::memory_order_acquire);
+        }
+    }
+    return total;
+}
+
+bool Trace::write(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to write trace " << path << std::endl;
+        return false;
+    }
+
+    // timestamps are microseconds since tracing was first turned on
+    const double toMicros = 1e6 / SDL_GetPerformanceFrequency();
+    const Uint64 start = startTicks.load();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) out << ",\n";
+        first = false;
+    };
+
+    // every thread keeps recording meanwhile, only finished events are read
+    for (int i = 0; i < registeredThreads(); ++i) {
+        const ThreadBuffer* buffer = &buffers[i];
+        const int id = i + 1;
+        const char* name = buffer->name.load(std::memory_order_relaxed);
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id
+            << ",\"args\":{\"name\":\"" << (name ? name : "thread") << "\"}}";
+
+        for (Chunk* chunk = buffer->first.load(std::memory_order_acquire); chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            size_t count = chunk->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                const Event& event = chunk->events[i];
+                double ts = event.ticks >= start ? (event.ticks - start) * toMicros : 0.0;
+                separator();
+                out << "{\"name\":\"" << event.name << "\",\"ph\":\"" << event.phase
+                    << "\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << id << "}";
+            }
+        }
+
+        Uint64 dropped = buffer->dropped.load(std::memory_order_relaxed);
+        if (dropped > 0) {
+            std::cerr << "Trace: " << (name ? name : "thread") << " dropped " << dropped
+                      << " events, its buffer was full or the chunk pool ran dry" << std::endl;
+        }
+    }
+
+    Uint64 unregistered = unregisteredDropped.load(std::memory_order_relaxed);
+    if (unregistered > 0) {
+        std::cerr << "Trace: dropped " << unregistered << " events from threads past the first "
+                  << MAX_THREADS << std::endl;
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
@@ -1,28 +1,51 @@
 #include "../headers/UIRenderer.h"
+#include "../headers/AssetIO.h"
+#include <algorithm>
 #include <iostream>
 
 UIRenderer::UIRenderer(SDL_Renderer* renderer, const std::string& fontPath,
                        int normalFontSize, int largeFontSize)
-    : renderer_(renderer), normalFont_(nullptr), largeFont_(nullptr), initialized_(false) {
+    : renderer_(renderer), normalFont_(nullptr), largeFont_(nullptr), initialized_(false),
+      textCacheBytes_(0), textCacheHits_(0), textCacheMisses_(0), textCacheEvictions_(0) {
     
-    normalFont_ = TTF_OpenFont(fontPath.c_str(), normalFontSize);
+    normalFont_ = TTF_OpenFontRW(AssetIO::open(fontPath), 1, normalFontSize);
     if (!normalFont_) {
         std::cerr << "Failed to load normal font: " << TTF_GetError() << std::endl;
         return;
     }
 
-    largeFont_ = TTF_OpenFont(fontPath.c_str(), largeFontSize);
-    if (!largeFont_) {
-        std::cerr << "Failed to load large font: " << TTF_GetError() << std::endl;
-        TTF_CloseFont(normalFont_);
-        normalFont_ = nullptr;
+    // same size twice would just be a second copy of the same glyphs
+    if (largeFontSize != normalFontSize) {
+        largeFont_ = TTF_OpenFontRW(AssetIO::open(fontPath), 1, largeFontSize);
+        if (!largeFont_) {
+            std::cerr << "Failed to load large font: " << TTF_GetError() << std::endl;
+            TTF_CloseFont(normalFont_);
+            normalFont_ = nullptr;
+            return;
+        }
+    }
+
+    // all the rasterizing happens here, drawing text later is just quads
+    if (!buildAtlas(normalFont_, normalAtlas_) || (largeFont_ && !buildAtlas(largeFont_, largeAtlas_))) {
+        std::cerr << "Failed to build glyph atlas: " << SDL_GetError() << std::endl;
         return;
     }
 
+    // 4 vertices and 6 indices per glyph, enough for any HUD string
+    vertices_.reserve(64 * 4);
+    indices_.reserve(64 * 6);
+
     initialized_ = true;
 }
 
 UIRenderer::~UIRenderer() {
+    clearTextCache();
+    if (normalAtlas_.texture) {
+        SDL_DestroyTexture(normalAtlas_.texture);
+    }
+    if (largeAtlas_.texture) {
+        SDL_DestroyTexture(largeAtlas_.texture);
+    }
     if (normalFont_) {
         TTF_CloseFont(normalFont_);
     }
@@ -35,50 +58,266 @@ void UIRenderer::renderText(const std::string& text, int x, int y,
                            int fontSize, const SDL_Color& color) {
     if (!initialized_) return;
 
-    TTF_Font* font = (fontSize == 0) ? normalFont_ : largeFont_;
-    renderTextWithFont(text, x, y, font, color);
+    const CachedText* cached = getCachedText(text, fontSize, color);
+    if (!cached) {
+        drawText(atlasFor(fontSize), text, x, y, color);
+        return;
+    }
+
+    SDL_Rect textRect = {x, y, cached->width, cached->height};
+    SDL_RenderCopy(renderer_, cached->texture, nullptr, &textRect);
 }
 
 void UIRenderer::renderTextCentered(const std::string& text, int centerX, int centerY,
                                     int fontSize, const SDL_Color& color) {
     if (!initialized_) return;
 
-    TTF_Font* font = (fontSize == 0) ? normalFont_ : largeFont_;
-    
-    // surface to measure text dimensions
-    SDL_Surface* textSurface = TTF_RenderText_Solid(font, text.c_str(), color);
-    if (!textSurface) return;
+    const CachedText* cached = getCachedText(text, fontSize, color);
+    if (cached) {
+        SDL_Rect textRect = {centerX - cached->width / 2, centerY - cached->height / 2,
+                             cached->width, cached->height};
+        SDL_RenderCopy(renderer_, cached->texture, nullptr, &textRect);
+        return;
+    }
+
+    int textWidth, textHeight;
+    measureText(text, fontSize, textWidth, textHeight);
 
-    int textWidth = textSurface->w;
-    int textHeight = textSurface->h;
-    
     // center the text
     int x = centerX - (textWidth / 2);
     int y = centerY - (textHeight / 2);
-    
-    SDL_FreeSurface(textSurface);
-    renderTextWithFont(text, x, y, font, color);
+
+    drawText(atlasFor(fontSize), text, x, y, color);
 }
 
-void UIRenderer::renderTextWithFont(const std::string& text, int x, int y,
-                                    TTF_Font* font, const SDL_Color& color) {
-    if (!font || !renderer_) return;
+void UIRenderer::renderTextDynamic(const std::string& text, int x, int y,
+                                   int fontSize, const SDL_Color& color) {
+    if (!initialized_) return;
 
-    SDL_Surface* textSurface = TTF_RenderText_Solid(font, text.c_str(), color);
-    if (!textSurface) return;
+    drawText(atlasFor(fontSize), text, x, y, color);
+}
 
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer_, textSurface);
-    if (!textTexture) {
+void UIRenderer::measureText(const std::string& text, int fontSize, int& width, int& height) const {
+    width = 0;
+    height = 0;
+    if (!initialized_) return;
+
+    const GlyphAtlas& atlas = atlasFor(fontSize);
+    int penX = 0;
+    int previous = -1;
+
+    for (unsigned char c : text) {
+        if (c < FIRST_GLYPH || c > LAST_GLYPH) {
+            previous = -1;
+            continue;
+        }
+
+        int index = c - FIRST_GLYPH;
+        if (previous >= 0) penX += atlas.kerning[previous * GLYPH_COUNT + index];
+
+        const Glyph& glyph = atlas.glyphs[index];
+        width = std::max(width, penX + glyph.src.w);
+        penX += glyph.advance;
+        previous = index;
+    }
+
+    height = atlas.lineHeight;
+}
+
+const UIRenderer::GlyphAtlas& UIRenderer::atlasFor(int fontSize) const {
+    return usesLargeFont(fontSize) ? largeAtlas_ : normalAtlas_;
+}
+
+bool UIRenderer::buildAtlas(TTF_Font* font, GlyphAtlas& atlas) {
+    const SDL_Color white = {255, 255, 255, 255}; // tinted per draw through vertex colors
+    SDL_Surface* glyphSurfaces[GLYPH_COUNT] = {};
+
+    // render every glyph and shelf them into rows
+    int penX = 0, penY = 0, rowHeight = 0;
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        Uint16 c = static_cast<Uint16>(FIRST_GLYPH + i);
+        Glyph& glyph = atlas.glyphs[i];
+        glyph.src = SDL_Rect{0, 0, 0, 0};
+        glyph.advance = 0;
+
+        int minX, maxX, minY, maxY;
+        if (TTF_GlyphMetrics(font, c, &minX, &maxX, &minY, &maxY, &glyph.advance) != 0) continue;
+
+        SDL_Surface* surface = TTF_RenderGlyph_Blended(font, c, white);
+        if (!surface) continue;
+
+        if (penX + surface->w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + 1;
+            rowHeight = 0;
+        }
+
+        glyph.src = SDL_Rect{penX, penY, surface->w, surface->h};
+        penX += surface->w + 1; // 1px gap so filtering never samples a neighbour
+        rowHeight = std::max(rowHeight, surface->h);
+        glyphSurfaces[i] = surface;
+    }
+
+    atlas.width = ATLAS_WIDTH;
+    atlas.height = std::max(1, penY + rowHeight);
+
+    // fresh surfaces are zeroed, so everything between glyphs is transparent
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, atlas.width, atlas.height, 32, SDL_PIXELFORMAT_RGBA32);
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        if (!glyphSurfaces[i]) continue;
+        if (sheet) {
+            // straight copy, keep the glyph alpha instead of blending onto nothing
+            SDL_SetSurfaceBlendMode(glyphSurfaces[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dst = atlas.glyphs[i].src;
+            SDL_BlitSurface(glyphSurfaces[i], nullptr, sheet, &dst);
+        }
+        SDL_FreeSurface(glyphSurfaces[i]);
+    }
+    if (!sheet) return false;
+
+    atlas.texture = SDL_CreateTextureFromSurface(renderer_, sheet);
+    SDL_FreeSurface(sheet);
+    if (!atlas.texture) return false;
+    SDL_SetTextureBlendMode(atlas.texture, SDL_BLENDMODE_BLEND);
+
+    atlas.lineHeight = TTF_FontHeight(font);
+
+    // kerning for every pair up front, so drawing never calls into freetype
+    atlas.kerning.assign(GLYPH_COUNT * GLYPH_COUNT, 0);
+    for (int previous = 0; previous < GLYPH_COUNT; ++previous) {
+        for (int current = 0; current < GLYPH_COUNT; ++current) {
+            atlas.kerning[previous * GLYPH_COUNT + current] =
+                TTF_GetFontKerningSizeGlyphs(font, static_cast<Uint16>(FIRST_GLYPH + previous),
+                                             static_cast<Uint16>(FIRST_GLYPH + current));
+        }
+    }
+
+    return true;
+}
+
+void UIRenderer::drawText(const GlyphAtlas& atlas, const std::string& text, int x, int y,
+                          const SDL_Color& color) {
+    if (!atlas.texture || !renderer_) return;
+
+    vertices_.clear();
+    indices_.clear();
+
+    const float uScale = 1.0f / atlas.width;
+    const float vScale = 1.0f / atlas.height;
+    int penX = x;
+    int previous = -1;
+
+    for (unsigned char c : text) {
+        if (c < FIRST_GLYPH || c > LAST_GLYPH) {
+            previous = -1;
+            continue;
+        }
+
+        int index = c - FIRST_GLYPH;
+        if (previous >= 0) penX += atlas.kerning[previous * GLYPH_COUNT + index];
+
+        const Glyph& glyph = atlas.glyphs[index];
+        if (glyph.src.w > 0) {
+            float left = static_cast<float>(penX);
+            float top = static_cast<float>(y);
+            float right = left + glyph.src.w;
+            float bottom = top + glyph.src.h;
+            float u0 = glyph.src.x * uScale;
+            float v0 = glyph.src.y * vScale;
+            float u1 = (glyph.src.x + glyph.src.w) * uScale;
+            float v1 = (glyph.src.y + glyph.src.h) * vScale;
+
+            int first = static_cast<int>(vertices_.size());
+            vertices_.push_back(SDL_Vertex{{left, top}, color, {u0, v0}});
+            vertices_.push_back(SDL_Vertex{{right, top}, color, {u1, v0}});
+            vertices_.push_back(SDL_Vertex{{right, bottom}, color, {u1, v1}});
+            vertices_.push_back(SDL_Vertex{{left, bottom}, color, {u0, v1}});
+
+            int quad[6] = {first, first + 1, first + 2, first, first + 2, first + 3};
+            indices_.insert(indices_.end(), quad, quad + 6);
+        }
+
+        penX += glyph.advance;
+        previous = index;
+    }
+
+    // whole string in one draw call
+    if (!indices_.empty()) {
+        SDL_RenderGeometry(renderer_, atlas.texture,
+                           vertices_.data(), static_cast<int>(vertices_.size()),
+                           indices_.data(), static_cast<int>(indices_.size()));
+    }
+}
+
+const UIRenderer::CachedText* UIRenderer::getCachedText(const std::string& text, int fontSize,
+                                                        const SDL_Color& color) {
+    if (text.empty()) return nullptr;
+
+    // key is font + color + text, packed into one string
+    lookupKey_.clear();
+    lookupKey_.push_back(usesLargeFont(fontSize) ? 'l' : 'n');
+    lookupKey_.push_back(static_cast<char>(color.r));
+    lookupKey_.push_back(static_cast<char>(color.g));
+    lookupKey_.push_back(static_cast<char>(color.b));
+    lookupKey_.push_back(static_cast<char>(color.a));
+    lookupKey_ += text;
+
+    auto found = textCacheIndex_.find(lookupKey_);
+    if (found != textCacheIndex_.end()) {
+        ++textCacheHits_;
+        textCache_.splice(textCache_.begin(), textCache_, found->second); // now most recent
+        return &textCache_.front();
+    }
+
+    ++textCacheMisses_;
+
+    TTF_Font* font = usesLargeFont(fontSize) ? largeFont_ : normalFont_;
+    SDL_Surface* textSurface = TTF_RenderText_Blended(font, text.c_str(), color);
+    if (!textSurface) return nullptr;
+
+    size_t bytes = static_cast<size_t>(textSurface->w) * textSurface->h * 4;
+    if (bytes > TEXT_CACHE_MAX_BYTES) {
         SDL_FreeSurface(textSurface);
-        return;
+        return nullptr;
     }
 
-    int textWidth, textHeight;
-    SDL_QueryTexture(textTexture, nullptr, nullptr, &textWidth, &textHeight);
-    
-    SDL_Rect textRect = {x, y, textWidth, textHeight};
-    SDL_RenderCopy(renderer_, textTexture, nullptr, &textRect);
-    
-    SDL_DestroyTexture(textTexture);
+    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer_, textSurface);
+    int width = textSurface->w;
+    int height = textSurface->h;
     SDL_FreeSurface(textSurface);
+    if (!textTexture) return nullptr;
+
+    evictText(bytes);
+
+    textCache_.push_front(CachedText{lookupKey_, textTexture, width, height, bytes});
+    textCacheIndex_[lookupKey_] = textCache_.begin();
+    textCacheBytes_ += bytes;
+    return &textCache_.front();
+}
+
+void UIRenderer::evictText(size_t incomingBytes) {
+    while (!textCache_.empty() &&
+           (textCacheBytes_ + incomingBytes > TEXT_CACHE_MAX_BYTES ||
+            textCache_.size() >= TEXT_CACHE_MAX_ENTRIES)) {
+        CachedText& oldest = textCache_.back();
+        SDL_DestroyTexture(oldest.texture);
+        textCacheBytes_ -= oldest.bytes;
+        textCacheIndex_.erase(oldest.key);
+        textCache_.pop_back();
+        ++textCacheEvictions_;
+    }
+}
+
+void UIRenderer::clearTextCache() {
+    for (CachedText& entry : textCache_) {
+        SDL_DestroyTexture(entry.texture);
+    }
+    textCache_.clear();
+    textCacheIndex_.clear();
+    textCacheBytes_ = 0;
+}
+
+TextCacheStats UIRenderer::getTextCacheStats() const {
+    return TextCacheStats{textCache_.size(), textCacheBytes_, TEXT_CACHE_MAX_BYTES,
+                          textCacheHits_, textCacheMisses_, textCacheEvictions_};
 }
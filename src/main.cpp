@@ -6,32 +6,65 @@
 #include "../headers/StartScreen.h"
 #include "../headers/Sound.h"
 #include "../headers/GameConstants.h"
+#include "../headers/LaunchOptions.h"
+#include "../headers/HeadlessRunner.h"
+#include "../headers/SimulationThread.h"
+#include "../headers/AssetManager.h"
+#include "../headers/AssetLoader.h"
+#include "../headers/AssetIO.h"
+#include "../headers/LoadingScreen.h"
+#include "../headers/InputRecording.h"
+#include "../headers/Profiler.h"
+#include "../headers/ProfilerOverlay.h"
+#include "../headers/Trace.h"
+#include "../headers/JobSystem.h"
+#include "../headers/FramePacer.h"
+#include <vector>
 
 int main(int argc, char* argv[]) {
-    if (!SDLManager::initialize()) {
-        std::cerr << "Failed to initialize SDL!" << std::endl;
+    LaunchOptions options;
+    if (!LaunchOptions::parse(argc, argv, options)) {
         return 1;
     }
 
-    Sounds sounds;
-    if (!sounds.init()) {
-        std::cerr << "Failed to initialize sound system!" << std::endl;
-        SDLManager::cleanup();
-        return 1;
+    // on this early so asset loading is on the timeline too
+    Trace::setThreadName("main");
+    Trace::setEnabled(options.trace);
+
+    // files packed into the archive are served from it, the rest stay loose
+    if (AssetIO::mount(GameConstants::ASSET_ARCHIVE_PATH)) {
+        std::cout << "Mounted " << GameConstants::ASSET_ARCHIVE_PATH << " ("
+                  << AssetIO::getEntryCount() << " files)" << std::endl;
     }
 
-    if (!sounds.loadMusic(GameConstants::MUSIC_PATH)) {
+    if (options.headless) {
+        if (!SDLManager::initialize(true)) {
+            std::cerr << "Failed to initialize SDL!" << std::endl;
+            return 1;
+        }
+        HeadlessRunner runner(options);
+        int result = runner.run();
         SDLManager::cleanup();
+        return result;
+    }
+
+    if (!SDLManager::initialize()) {
+        std::cerr << "Failed to initialize SDL!" << std::endl;
         return 1;
     }
 
-    if (!sounds.loadGunSound(GameConstants::GUN_SOUND_PATH)) {
+    AudioConfig audioConfig = options.lowLatencyAudio ? AudioConfig::lowLatency() : AudioConfig();
+    if (options.audioBufferSamples > 0) {
+        audioConfig.bufferSamples = options.audioBufferSamples;
+    }
+
+    Sounds sounds;
+    if (!sounds.init(audioConfig)) {
+        std::cerr << "Failed to initialize sound system!" << std::endl;
         SDLManager::cleanup();
         return 1;
     }
 
-    sounds.playMusic();
-
     SDL_Window* window = SDL_CreateWindow("Raumkūkan",
                                           SDL_WINDOWPOS_CENTERED,
                                           SDL_WINDOWPOS_CENTERED,
@@ -45,7 +78,9 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+    if (options.vsync) rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, rendererFlags);
     if (!renderer) {
         std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
         SDL_DestroyWindow(window);
@@ -53,69 +88,243 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    AnimatedBackground background(renderer, 
-                                  GameConstants::BACKGROUND_FOLDER_PATH,
-                                  GameConstants::BACKGROUND_FRAME_COUNT,
+    // vsync is only a request, some drivers ignore it and present returns at once.
+    // without it the limiter keeps the loop at the display rate instead of thousands of fps
+    SDL_RendererInfo rendererInfo;
+    bool vsync = options.vsync && SDL_GetRendererInfo(renderer, &rendererInfo) == 0 &&
+                 (rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC);
+    int targetFps = options.targetFps;
+    if (targetFps == 0 && !vsync) {
+        SDL_DisplayMode mode;
+        bool known = SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &mode) == 0 && mode.refresh_rate > 0;
+        targetFps = known ? mode.refresh_rate : GameConstants::DEFAULT_TARGET_FPS;
+    }
+    FramePacer pacer(targetFps);
+
+    // everything slow to decode loads in parallel while a progress bar is drawn,
+    // gpu uploads happen here on the render thread as each file finishes
+    AssetManager assets(renderer);
+    std::vector<SDL_Surface*> backgroundFrames(GameConstants::BACKGROUND_FRAME_COUNT, nullptr);
+    bool soundsLoaded = false;
+    bool quit = false;
+    {
+        AssetLoader loader;
+        // one job for both, SDL_mixer sets up its mp3 decoder on first use and that isnt thread safe
+        loader.add([&]() {
+            soundsLoaded = sounds.loadMusic(GameConstants::MUSIC_PATH) &&
+                           sounds.loadGunSound(GameConstants::GUN_SOUND_PATH);
+            return soundsLoaded;
+        });
+        for (int i = 0; i < GameConstants::BACKGROUND_FRAME_COUNT; ++i) {
+            loader.add([&backgroundFrames, i]() {
+                backgroundFrames[i] = AnimatedBackground::decodeFrame(GameConstants::BACKGROUND_FOLDER_PATH, i);
+                return backgroundFrames[i] != nullptr;
+            });
+        }
+        loader.addTexture(assets, GameConstants::PLAYER_TEXTURE_PATH);
+        loader.addTexture(assets, GameConstants::BULLET_TEXTURE_PATH);
+        loader.addTexture(assets, GameConstants::ASTEROID_TEXTURE_PATH);
+        loader.addTexture(assets, GameConstants::ASTEROID2_TEXTURE_PATH);
+
+        LoadingScreen loadingScreen(renderer, GameConstants::SCREEN_WIDTH, GameConstants::SCREEN_HEIGHT);
+        Uint64 loadStart = SDL_GetPerformanceCounter();
+        SDL_Event event;
+
+        while (!loader.isDone() && !quit) {
+            TRACE_SCOPE("loading frame");
+            while (SDL_PollEvent(&event)) {
+                if (event.type == SDL_QUIT) quit = true;
+            }
+
+            // sleeps until a job completes, at most about one frame
+            loader.pump(16);
+
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+            loadingScreen.render(loader.getProgress());
+            SDL_RenderPresent(renderer);
+        }
+
+        if (!quit) {
+            double loadMs = (SDL_GetPerformanceCounter() - loadStart) * 1000.0 / SDL_GetPerformanceFrequency();
+            std::cout << "Loaded assets in " << loadMs << " ms on " << loader.getThreadCount()
+                      << " threads (" << loader.getFailedCount() << " failed)" << std::endl;
+        }
+    } // loader joins its workers here, before anything below can shut SDL down
+
+    if (quit || !soundsLoaded) {
+        for (SDL_Surface* frame : backgroundFrames) {
+            if (frame) SDL_FreeSurface(frame);
+        }
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDLManager::cleanup();
+        return quit ? 0 : 1;
+    }
+
+    sounds.playMusic();
+
+    AnimatedBackground background(renderer, std::move(backgroundFrames),
                                   GameConstants::BACKGROUND_FRAME_DELAY_MS);
-    
-    StartScreen startScreen(renderer, 
+    AnimatedBackground::MemoryUsage backgroundMemory = background.getMemoryUsage();
+    std::cout << "Background: " << background.getFrameCount() << " frames, "
+              << (background.isStreaming() ? "streaming texture" : "sprite sheet") << ", "
+              << backgroundMemory.textureBytes / (1024 * 1024) << " MB texture, "
+              << backgroundMemory.cpuBytes / (1024 * 1024) << " MB decoded" << std::endl;
+
+    StartScreen startScreen(renderer, &assets,
                            GameConstants::SCREEN_WIDTH, 
                            GameConstants::SCREEN_HEIGHT);
     
     Game game(renderer, 
               GameConstants::SCREEN_WIDTH,
               GameConstants::SCREEN_HEIGHT,
-              &sounds);
+              &sounds, &assets);
+
+    // the simulation thread hands its big loops to these, --threads counts it too
+    JobSystem jobs(options.threads - 1);
+    game.setJobSystem(&jobs);
+
+    // a fresh game every launch unless the seed is pinned, the recording keeps it either way
+    uint64_t seed = options.seedSet ? options.seed : SDL_GetPerformanceCounter();
+    game.setSeed(seed);
+
+    InputRecorder recorder;
+    if (!options.recordPath.empty()) {
+        RecordingHeader header;
+        header.seed = seed;
+        header.tickRate = options.tickRate;
+        header.screenWidth = GameConstants::SCREEN_WIDTH;
+        header.screenHeight = GameConstants::SCREEN_HEIGHT;
+        if (recorder.open(options.recordPath, header)) {
+            game.setRecorder(&recorder);
+        }
+    }
 
-    Uint32 lastFrameTime = SDL_GetTicks();
+    // Game::update runs over there from the start click on, this thread only handles events and draws
+    SimulationThread simulation(game, options.tickRate, GameConstants::MAX_CATCHUP_STEPS);
     bool running = true;
     SDL_Event event;
 
+    Profiler::setEnabled(options.profile);
+    ProfilerOverlay profilerOverlay(renderer, GameConstants::SCREEN_WIDTH);
+
     // game loop
     while (running) {
-        // delta time
-        Uint32 currentFrameTime = SDL_GetTicks();
-        float deltaTime = (currentFrameTime - lastFrameTime) / 1000.0f;
-        lastFrameTime = currentFrameTime;
+        Profiler::beginFrame();
+        Trace::refill();
 
         // events
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                running = false;
-            }
+        {
+            PROFILE_SCOPE(Events);
+            while (SDL_PollEvent(&event)) {
+                if (event.type == SDL_QUIT) {
+                    running = false;
+                }
 
-            if (!game.isGameStarted()) {
-                startScreen.handleEvent(event);
-                if (startScreen.shouldStartGame()) {
-                    game.initialize();
+                if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3 && !event.key.repeat) {
+                    profilerOverlay.toggle();
                 }
-            } else {
-                game.handleEvent(event);
-            }
-        }
 
-        // game state
-        if (game.isGameStarted()) {
-            if (!game.update(deltaTime)) {
-                // game over
-                running = false;
+                // first press starts recording, every press after that writes what is there so far
+                if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F4 && !event.key.repeat) {
+                    if (!Trace::isEnabled()) {
+                        Trace::setEnabled(true);
+                        std::cout << "Tracing, F4 again writes " << GameConstants::TRACE_PATH << std::endl;
+                    } else if (Trace::write(GameConstants::TRACE_PATH)) {
+                        std::cout << "Wrote " << Trace::getEventCount() << " trace events to "
+                                  << GameConstants::TRACE_PATH << std::endl;
+                    }
+                }
+
+                if (!game.isGameStarted()) {
+                    startScreen.handleEvent(event);
+                    if (startScreen.shouldStartGame()) {
+                        game.initialize();
+                        simulation.start();
+                    }
+                } else {
+                    game.handleEvent(event);
+                }
             }
         }
 
-        background.update();
+        // game over
+        if (simulation.isFinished()) {
+            running = false;
+        }
 
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
 
-        background.render();
+        {
+            PROFILE_SCOPE(Background);
+            background.update();
+            background.render();
+        }
 
         if (!game.isGameStarted()) {
             startScreen.render();
         } else {
-            game.render();
+            const GameSnapshot& snapshot = simulation.acquireSnapshot();
+            game.render(snapshot, simulation.getAlpha(snapshot));
+        }
+
+        profilerOverlay.render();
+
+        {
+            PROFILE_SCOPE(Present);
+            SDL_RenderPresent(renderer);
+        }
+        {
+            PROFILE_SCOPE(Idle);
+            pacer.wait();
         }
+        Profiler::endFrame();
+    }
+
+    // nothing below may race the simulation: recorder, sounds and the state hash are its
+    simulation.stop();
+
+    if (Trace::isEnabled() && Trace::write(GameConstants::TRACE_PATH)) {
+        std::cout << "Wrote " << Trace::getEventCount() << " trace events to "
+                  << GameConstants::TRACE_PATH << std::endl;
+    }
+
+    if (Profiler::getFrameCount() > 0 && Profiler::writeCsv(GameConstants::PROFILE_CSV_PATH)) {
+        std::cout << "Wrote " << Profiler::getFrameCount() << " frames of timings to "
+                  << GameConstants::PROFILE_CSV_PATH << std::endl;
+    }
+
+    FramePacingStats pacing = pacer.getStats();
+    if (pacing.frames > 0) {
+        std::cout << "Frame pacing: " << (vsync ? "vsync" : "no vsync");
+        if (pacer.getTargetFps() > 0) std::cout << ", limited to " << pacer.getTargetFps() << " fps";
+        std::cout << ", avg " << pacing.averageMs << " ms, jitter " << pacing.jitterMs << " ms, worst "
+                  << pacing.worstMs << " ms, " << pacing.missedFrames << " missed, "
+                  << pacing.sleptMs / 1000.0f << " s slept, " << pacing.spunMs / 1000.0f << " s spun ("
+                  << pacing.spinMarginUs << " us spin margin)" << std::endl;
+    }
+
+    if (sounds.isMusicStreaming()) {
+        MusicStreamStats music = sounds.getMusicStats();
+        std::cout << "Music stream: " << music.segmentsDecoded << " segments decoded, "
+                  << music.underruns << " underruns, " << music.bufferBytes / 1024 << " KB buffer" << std::endl;
+    }
+
+    AudioLatencyStats latency = sounds.getLatencyStats();
+    if (latency.samples > 0) {
+        std::cout << "Sound effect latency: avg " << latency.averageMs << " ms, worst " << latency.worstMs
+                  << " ms over " << latency.samples << " sounds (" << latency.bufferMs << " ms device buffer, "
+                  << latency.trimmedMs << " ms leading silence trimmed, "
+                  << latency.stolenVoices << " voices stolen)" << std::endl;
+    }
 
-        SDL_RenderPresent(renderer);
+    if (recorder.isOpen()) {
+        recorder.close();
+        std::cout << "Recorded " << recorder.getTickCount() << " ticks to " << options.recordPath
+                  << " (seed " << seed << ", final state hash " << std::hex << game.getStateHash()
+                  << std::dec << "), play it back with --replay" << std::endl;
     }
 
     SDL_DestroyRenderer(renderer);
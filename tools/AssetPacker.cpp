@@ -0,0 +1,112 @@
+// build step: packs asset folders into one archive file that AssetIO maps
+// at startup, so shipping the game is the binary plus this one file.
+//
+//   assetpacker <assets.pak> <folder>...
+//
+// paths are stored the way the game asks for them, e.g. assets/player.png,
+// layout is described in headers/AssetIO.h
+#include "../headers/AssetIO.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Entry {
+    std::string path;
+    uint64_t offset;
+    uint64_t size;
+};
+
+template <typename T>
+void writeValue(std::ofstream& out, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+uint64_t alignUp(uint64_t value) {
+    return (value + AssetIO::DATA_ALIGN - 1) / AssetIO::DATA_ALIGN * AssetIO::DATA_ALIGN;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <assets.pak> <folder>..." << std::endl;
+        return 1;
+    }
+    const std::string archivePath = argv[1];
+
+    std::vector<Entry> entries;
+    for (int i = 2; i < argc; ++i) {
+        std::error_code error;
+        for (const auto& file : fs::recursive_directory_iterator(argv[i], error)) {
+            if (!file.is_regular_file()) continue;
+            entries.push_back(Entry{file.path().generic_string(), 0, file.file_size()});
+        }
+        if (error) {
+            std::cerr << "Failed to read " << argv[i] << ": " << error.message() << std::endl;
+            return 1;
+        }
+    }
+
+    // sorted so the same assets always give the same archive
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.path < b.path;
+    });
+
+    // index size first, then every file gets the next aligned offset after it
+    uint64_t offset = sizeof(AssetIO::MAGIC) + sizeof(uint32_t);
+    for (const Entry& entry : entries) {
+        offset += sizeof(uint16_t) + entry.path.size() + sizeof(uint64_t) * 2;
+    }
+    for (Entry& entry : entries) {
+        offset = alignUp(offset);
+        entry.offset = offset;
+        offset += entry.size;
+    }
+
+    std::ofstream out(archivePath, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to create " << archivePath << std::endl;
+        return 1;
+    }
+
+    out.write(AssetIO::MAGIC, sizeof(AssetIO::MAGIC));
+    writeValue<uint32_t>(out, static_cast<uint32_t>(entries.size()));
+    for (const Entry& entry : entries) {
+        writeValue<uint16_t>(out, static_cast<uint16_t>(entry.path.size()));
+        out.write(entry.path.data(), entry.path.size());
+        writeValue<uint64_t>(out, entry.offset);
+        writeValue<uint64_t>(out, entry.size);
+    }
+
+    std::vector<char> contents;
+    for (const Entry& entry : entries) {
+        while (static_cast<uint64_t>(out.tellp()) < entry.offset) out.put('\0');
+
+        std::ifstream in(entry.path, std::ios::binary);
+        contents.resize(entry.size);
+        if (!in.read(contents.data(), contents.size())) {
+            std::cerr << "Failed to read " << entry.path << std::endl;
+            return 1;
+        }
+        out.write(contents.data(), contents.size());
+    }
+
+    if (!out) {
+        std::cerr << "Failed to write " << archivePath << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << entries.size() << " files (" << offset / 1024 << " KB) into "
+              << archivePath << std::endl;
+    return 0;
+}
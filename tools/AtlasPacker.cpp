@@ -0,0 +1,166 @@
+// build step: packs the game sprites into one atlas texture so the whole
+// scene can be drawn with a single texture bind. each sprite's downscaled
+// levels are packed next to it, so drawing from a smaller level still uses
+// the same texture.
+//
+//   atlaspacker <atlas.png> <atlas.manifest> <sprite.png>...
+//
+// writes the atlas png and a manifest the AssetManager reads at startup:
+//   page <atlas png> <width> <height>
+//   sprite <source png> <x> <y> <w> <h>
+//   level <source png> <n> <x> <y> <w> <h>   n-th halving of that sprite, 1 = half size
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include "../headers/GameConstants.h"
+#include "../headers/ImageScale.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// transparent gap between sprites so linear filtering never bleeds a neighbour in
+const int PADDING = 2;
+const int MAX_ATLAS_SIZE = 8192;
+
+// one image on the page, either a sprite as drawn or one of its downscaled levels
+struct Sprite {
+    std::string path;
+    int level; // 0 is the source image, n is n halvings of it
+    SDL_Surface* surface;
+    SDL_Rect rect;
+};
+
+// shelf packing: tallest sprites first, fill rows left to right,
+// start a new row under the tallest one of the row before
+bool pack(std::vector<Sprite>& sprites, int size) {
+    int x = 0, y = 0, shelfHeight = 0;
+    for (Sprite& sprite : sprites) {
+        int w = sprite.surface->w + PADDING;
+        int h = sprite.surface->h + PADDING;
+        if (w > size) return false;
+
+        if (x + w > size) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (y + h > size) return false;
+
+        sprite.rect = SDL_Rect{x, y, sprite.surface->w, sprite.surface->h};
+        x += w;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << "usage: " << argv[0] << " <atlas.png> <atlas.manifest> <sprite.png>..." << std::endl;
+        return 1;
+    }
+    const std::string atlasPath = argv[1];
+    const std::string manifestPath = argv[2];
+
+    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        std::cerr << "IMG_Init failed: " << IMG_GetError() << std::endl;
+        return 1;
+    }
+
+    std::vector<Sprite> sprites;
+    for (int i = 3; i < argc; ++i) {
+        SDL_Surface* loaded = IMG_Load(argv[i]);
+        if (!loaded) {
+            std::cerr << "Failed to load " << argv[i] << ": " << IMG_GetError() << std::endl;
+            return 1;
+        }
+        // one pixel format for everything so blitting keeps the alpha as is
+        SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (!surface) {
+            std::cerr << "Failed to convert " << argv[i] << ": " << SDL_GetError() << std::endl;
+            return 1;
+        }
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+        sprites.push_back(Sprite{argv[i], 0, surface, SDL_Rect{0, 0, 0, 0}});
+
+        // same levels the AssetManager would make for a loose png, made the same way
+        for (int level = 1; level <= GameConstants::TEXTURE_MIP_LEVELS; ++level) {
+            SDL_Surface* previous = sprites.back().surface;
+            if (previous->w < 2 || previous->h < 2) break;
+
+            SDL_Surface* half = ImageScale::half(previous);
+            if (!half) {
+                std::cerr << "Failed to downscale " << argv[i] << ": " << SDL_GetError() << std::endl;
+                return 1;
+            }
+            SDL_SetSurfaceBlendMode(half, SDL_BLENDMODE_NONE);
+            sprites.push_back(Sprite{argv[i], level, half, SDL_Rect{0, 0, 0, 0}});
+        }
+    }
+
+    std::stable_sort(sprites.begin(), sprites.end(), [](const Sprite& a, const Sprite& b) {
+        return a.surface->h > b.surface->h;
+    });
+
+    // smallest power of two square that fits, gpus are happiest with those
+    int size = 64;
+    while (size <= MAX_ATLAS_SIZE && !pack(sprites, size)) {
+        size *= 2;
+    }
+    if (size > MAX_ATLAS_SIZE) {
+        std::cerr << "Sprites do not fit in a " << MAX_ATLAS_SIZE << " atlas" << std::endl;
+        return 1;
+    }
+
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlas) {
+        std::cerr << "Failed to create atlas surface: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+    // new surfaces come zeroed, so the padding is already transparent
+    for (Sprite& sprite : sprites) {
+        SDL_BlitSurface(sprite.surface, nullptr, atlas, &sprite.rect);
+        SDL_FreeSurface(sprite.surface);
+        sprite.surface = nullptr;
+    }
+
+    if (IMG_SavePNG(atlas, atlasPath.c_str()) != 0) {
+        std::cerr << "Failed to write " << atlasPath << ": " << IMG_GetError() << std::endl;
+        SDL_FreeSurface(atlas);
+        return 1;
+    }
+    SDL_FreeSurface(atlas);
+
+    std::ofstream manifest(manifestPath);
+    manifest << "# generated by tools/AtlasPacker.cpp, do not edit\n";
+    manifest << "page " << atlasPath << " " << size << " " << size << "\n";
+    // packing shuffled them by height. the manifest lists every sprite first, then the levels
+    // from half size down, so each level line comes after the one before it
+    std::stable_sort(sprites.begin(), sprites.end(), [](const Sprite& a, const Sprite& b) {
+        return a.level < b.level;
+    });
+    for (const Sprite& sprite : sprites) {
+        if (sprite.level == 0) {
+            manifest << "sprite " << sprite.path << " ";
+        } else {
+            manifest << "level " << sprite.path << " " << sprite.level << " ";
+        }
+        manifest << sprite.rect.x << " " << sprite.rect.y << " "
+                 << sprite.rect.w << " " << sprite.rect.h << "\n";
+    }
+    if (!manifest) {
+        std::cerr << "Failed to write " << manifestPath << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << sprites.size() << " sprites and levels into a "
+              << size << "x" << size << " atlas" << std::endl;
+
+    IMG_Quit();
+    return 0;
+}
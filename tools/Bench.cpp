@@ -0,0 +1,367 @@
+// `make bench`: timings for the hot parts of the game logic, run headless
+// so the numbers are the simulation alone (no window, gpu or audio).
+//
+//   bench [filter]
+//
+// every benchmark is run with more and more iterations until it takes at
+// least MIN_TIME, then reports ns and heap allocations per iteration.
+// micro benchmarks time one piece (asteroid step, grid, collisions, pools,
+// rounds), macro ones run whole Game::update ticks at a fixed density
+#include "../headers/Game.h"
+#include "../headers/Asteroid.h"
+#include "../headers/AsteroidField.h"
+#include "../headers/AssetManager.h"
+#include "../headers/Bullet.h"
+#include "../headers/EntityPool.h"
+#include "../headers/GameConstants.h"
+#include "../headers/JobSystem.h"
+#include "../headers/Player.h"
+#include "../headers/Random.h"
+#include "../headers/RoundManager.h"
+#include "../headers/SpatialGrid.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+// every heap allocation in the process goes through here so a benchmark
+// can tell how many happened while it was timing
+namespace {
+std::atomic<uint64_t> allocationCount{0};
+}
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+// the private steps of Game the micro benchmarks call one at a time
+struct GameBenchAccess {
+    static EntityPool<Bullet>& bullets(Game& game) { return game.bullets_; }
+    static AsteroidField& asteroids(Game& game) { return game.asteroids_; }
+    static RoundManager& rounds(Game& game) { return *game.roundManager_; }
+    static void rebuildGrid(Game& game) { game.collisionGrid_.rebuild(game.asteroids_); }
+    static void checkBulletAsteroidCollisions(Game& game) { game.checkBulletAsteroidCollisions(); }
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const double MIN_TIME = 0.25;        // seconds a benchmark has to run before its numbers count
+const uint64_t MAX_ITERATIONS = 1ull << 30;
+const float TICK = 1.0f / GameConstants::SIMULATION_TICK_RATE;
+
+// handed to each benchmark, google benchmark style: set up, then
+// `while (state.keepRunning())` around the part being measured
+class BenchState {
+public:
+    explicit BenchState(uint64_t iterations)
+        : iterations_(iterations), remaining_(iterations), paused_(false),
+          elapsed_(0.0), allocations_(0) {
+    }
+
+    bool keepRunning() {
+        if (remaining_ == iterations_) start();
+        if (remaining_ == 0) {
+            stop();
+            return false;
+        }
+        --remaining_;
+        return true;
+    }
+
+    // keeps per tick housekeeping (refilling the scene, restarting after a
+    // death) out of the numbers
+    void pauseTiming() {
+        if (paused_) return;
+        stop();
+        paused_ = true;
+    }
+    void resumeTiming() {
+        if (!paused_) return;
+        paused_ = false;
+        start();
+    }
+
+    uint64_t getIterations() const { return iterations_; }
+    double getElapsed() const { return elapsed_; }
+    uint64_t getAllocations() const { return allocations_; }
+
+private:
+    uint64_t iterations_;
+    uint64_t remaining_;
+    bool paused_;
+    double elapsed_;
+    uint64_t allocations_;
+    Clock::time_point startTime_;
+    uint64_t startAllocations_ = 0;
+
+    void start() {
+        startAllocations_ = allocationCount.load(std::memory_order_relaxed);
+        startTime_ = Clock::now();
+    }
+    void stop() {
+        elapsed_ += std::chrono::duration<double>(Clock::now() - startTime_).count();
+        allocations_ += allocationCount.load(std::memory_order_relaxed) - startAllocations_;
+    }
+};
+
+struct Benchmark {
+    std::string name;
+    std::function<void(BenchState&)> run;
+};
+
+// size only handles, the benchmarks never draw
+AssetManager& sharedAssets() {
+    static AssetManager assets(nullptr);
+    return assets;
+}
+
+// one pool for every /jobs benchmark, so thread start up isnt in the numbers
+JobSystem& sharedJobs() {
+    static JobSystem jobs;
+    return jobs;
+}
+
+// asteroids rolled at the screen edge like the game does, then each one
+// homes on a random point for a random time so they end up spread over
+// the screen instead of all sitting on the border
+void fillAsteroids(AsteroidField& field, size_t count, Random& rng) {
+    TextureHandle textures[2] = {
+        sharedAssets().getTexture(GameConstants::ASTEROID_TEXTURE_PATH),
+        sharedAssets().getTexture(GameConstants::ASTEROID2_TEXTURE_PATH),
+    };
+    const int w = GameConstants::SCREEN_WIDTH;
+    const int h = GameConstants::SCREEN_HEIGHT;
+
+    while (field.size() < count) {
+        size_t i = field.size();
+        float targetX = rng.range(0.0f, w);
+        float targetY = rng.range(0.0f, h);
+        if (!field.spawn(Asteroid(textures[i % 2], rng, w, h, targetX, targetY))) break;
+        for (int step = rng.below(40); step > 0; --step) {
+            field.updateRange(i, i + 1, 0.05f, targetX, targetY);
+        }
+    }
+}
+
+void fillBullets(EntityPool<Bullet>& bullets, size_t count, Random& rng) {
+    TextureHandle texture = sharedAssets().getTexture(GameConstants::BULLET_TEXTURE_PATH);
+    const float w = GameConstants::SCREEN_WIDTH;
+    const float h = GameConstants::SCREEN_HEIGHT;
+
+    while (bullets.size() < count) {
+        if (!bullets.spawn(texture, rng.range(0.0f, w), rng.range(0.0f, h),
+                           rng.range(0.0f, w), rng.range(0.0f, h))) break;
+    }
+}
+
+void asteroidFieldUpdate(BenchState& state, size_t count, JobSystem* jobs = nullptr) {
+    Random rng(1);
+    AsteroidField field(count, GameConstants::SCREEN_WIDTH, GameConstants::SCREEN_HEIGHT);
+    fillAsteroids(field, count, rng);
+
+    // the player moves around so the homing math never settles into one case
+    float playerX = GameConstants::SCREEN_WIDTH / 2.0f;
+    float playerY = GameConstants::SCREEN_HEIGHT / 2.0f;
+    while (state.keepRunning()) {
+        if (jobs) {
+            // same split Game::updateAsteroids does
+            jobs->parallelFor(field.size(), GameConstants::JOB_ASTEROID_GRAIN, [&](size_t begin, size_t end) {
+                field.updateRange(begin, end, TICK, playerX, playerY);
+            });
+        } else {
+            field.update(TICK, playerX, playerY);
+        }
+        playerX = playerX > GameConstants::SCREEN_WIDTH ? 0.0f : playerX + 1.0f;
+    }
+}
+
+void spatialGridRebuild(BenchState& state, size_t count) {
+    Random rng(1);
+    AsteroidField field(count, GameConstants::SCREEN_WIDTH, GameConstants::SCREEN_HEIGHT);
+    fillAsteroids(field, count, rng);
+    SpatialGrid grid(GameConstants::SCREEN_WIDTH, GameConstants::SCREEN_HEIGHT,
+                     GameConstants::COLLISION_CELL_SIZE);
+
+    while (state.keepRunning()) {
+        grid.rebuild(field);
+    }
+}
+
+void bulletAsteroidCollisions(BenchState& state, size_t asteroidCount, size_t bulletCount,
+                              JobSystem* jobs = nullptr) {
+    Random rng(1);
+    Game game(nullptr, GameConstants::SCREEN_WIDTH, GameConstants::SCREEN_HEIGHT, nullptr, &sharedAssets());
+    game.setJobSystem(jobs);
+    game.initialize();
+    fillAsteroids(GameBenchAccess::asteroids(game), asteroidCount, rng);
+    fillBullets(GameBenchAccess::bullets(game), bulletCount, rng);
+    GameBenchAccess::rebuildGrid(game);
+
+    // only flags hits, nothing is removed so every iteration scans the same scene
+    while (state.keepRunning()) {
+        GameBenchAccess::checkBulletAsteroidCollisions(game);
+    }
+}
+
+void roundProgression(BenchState& state) {
+    // one iteration is one tick of what Game asks the round manager,
+    // with the field emptying a couple of ticks after each round is spawned
+    RoundManager rounds;
+    rounds.resetToRoundOne();
+    size_t activeAsteroids = 0;
+
+    while (state.keepRunning()) {
+        rounds.updateTransitionTimer(TICK);
+        if (rounds.shouldSpawnAsteroids(TICK)) {
+            rounds.markAsteroidsSpawned(GameConstants::ASTEROIDS_PER_SPAWN_EVENT);
+            activeAsteroids += GameConstants::ASTEROIDS_PER_SPAWN_EVENT;
+        } else if (activeAsteroids > 0) {
+            --activeAsteroids;
+        }
+        if (rounds.isRoundComplete(activeAsteroids)) {
+            rounds.advanceToNextRound();
+        }
+    }
+}
+
+void bulletPoolChurn(BenchState& state) {
+    // pool kept half full, every iteration is one spawn and one despawn
+    Random rng(1);
+    EntityPool<Bullet> bullets(GameConstants::MAX_BULLETS);
+    fillBullets(bullets, GameConstants::MAX_BULLETS / 2, rng);
+    TextureHandle texture = sharedAssets().getTexture(GameConstants::BULLET_TEXTURE_PATH);
+
+    size_t victim = 0;
+    while (state.keepRunning()) {
+        bullets.spawn(texture, 100.0f, 100.0f, 500.0f, 300.0f);
+        bullets.despawn(victim);
+        victim = (victim + 7) % bullets.size();
+    }
+}
+
+void asteroidFieldChurn(BenchState& state) {
+    // includes rolling the asteroid, which is what a spawn costs in the game
+    Random rng(1);
+    AsteroidField field(GameConstants::MAX_ASTEROIDS, GameConstants::SCREEN_WIDTH, GameConstants::SCREEN_HEIGHT);
+    fillAsteroids(field, GameConstants::MAX_ASTEROIDS / 2, rng);
+    TextureHandle texture = sharedAssets().getTexture(GameConstants::ASTEROID_TEXTURE_PATH);
+
+    size_t victim = 0;
+    while (state.keepRunning()) {
+        field.spawn(Asteroid(texture, rng, GameConstants::SCREEN_WIDTH, GameConstants::SCREEN_HEIGHT,
+                             640.0f, 360.0f));
+        field.despawn(victim);
+        victim = (victim + 7) % field.size();
+    }
+}
+
+// a late round game held at a fixed density: after every tick the field and
+// bullets are topped back up (untimed) and a death restarts at the same round
+void gameTick(BenchState& state, int round, size_t asteroidCount, size_t bulletCount,
+              JobSystem* jobs = nullptr) {
+    Random rng(1);
+    Game game(nullptr, GameConstants::SCREEN_WIDTH, GameConstants::SCREEN_HEIGHT, nullptr, &sharedAssets());
+    game.setSeed(1);
+    game.setJobSystem(jobs);
+
+    auto setUp = [&]() {
+        game.initialize();
+        RoundManager& rounds = GameBenchAccess::rounds(game);
+        while (rounds.getCurrentRound() < round) {
+            rounds.advanceToNextRound();
+        }
+    };
+    setUp();
+
+    // the scripted player shoots at a steady rate like the headless runs
+    InputState input;
+    input.mouseX = GameConstants::SCREEN_WIDTH;
+    input.mouseY = GameConstants::SCREEN_HEIGHT / 2;
+    uint64_t tick = 0;
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        if (game.isGameOver()) setUp();
+        fillAsteroids(GameBenchAccess::asteroids(game), asteroidCount, rng);
+        fillBullets(GameBenchAccess::bullets(game), bulletCount, rng);
+        input.shots = (tick++ % 6 == 0) ? 1 : 0;
+        game.setInput(input);
+        state.resumeTiming();
+
+        game.update(TICK);
+        game.flushAudio();
+    }
+}
+
+std::vector<Benchmark> allBenchmarks() {
+    return {
+        {"AsteroidField::update/1000", [](BenchState& s) { asteroidFieldUpdate(s, 1000); }},
+        {"AsteroidField::update/10000", [](BenchState& s) { asteroidFieldUpdate(s, 10000); }},
+        {"AsteroidField::update/10000/jobs", [](BenchState& s) { asteroidFieldUpdate(s, 10000, &sharedJobs()); }},
+        {"AsteroidField::update/100000", [](BenchState& s) { asteroidFieldUpdate(s, 100000); }},
+        {"AsteroidField::update/100000/jobs", [](BenchState& s) { asteroidFieldUpdate(s, 100000, &sharedJobs()); }},
+        {"SpatialGrid::rebuild/1000", [](BenchState& s) { spatialGridRebuild(s, 1000); }},
+        {"SpatialGrid::rebuild/10000", [](BenchState& s) { spatialGridRebuild(s, 10000); }},
+        {"Game::checkBulletAsteroidCollisions/1000x500",
+         [](BenchState& s) { bulletAsteroidCollisions(s, 1000, 500); }},
+        {"Game::checkBulletAsteroidCollisions/1000x500/jobs",
+         [](BenchState& s) { bulletAsteroidCollisions(s, 1000, 500, &sharedJobs()); }},
+        {"RoundManager/progression", roundProgression},
+        {"EntityPool<Bullet>/spawn+despawn", bulletPoolChurn},
+        {"AsteroidField/spawn+despawn", asteroidFieldChurn},
+        {"Game::update/round50/100x50", [](BenchState& s) { gameTick(s, 50, 100, 50); }},
+        {"Game::update/round50/1000x500", [](BenchState& s) { gameTick(s, 50, 1000, 500); }},
+        {"Game::update/round50/1000x500/jobs", [](BenchState& s) { gameTick(s, 50, 1000, 500, &sharedJobs()); }},
+    };
+}
+
+// more iterations until the run is long enough to trust, google benchmark style
+BenchState runBenchmark(const Benchmark& benchmark) {
+    uint64_t iterations = 1;
+    while (true) {
+        BenchState state(iterations);
+        benchmark.run(state);
+        if (state.getElapsed() >= MIN_TIME || iterations >= MAX_ITERATIONS) return state;
+
+        // aim a bit past MIN_TIME from what this run took, but never more than 10x at once
+        double perIteration = state.getElapsed() / iterations;
+        uint64_t next = perIteration > 0.0 ? static_cast<uint64_t>(MIN_TIME * 1.4 / perIteration) : iterations * 10;
+        iterations = std::max(iterations + 1, std::min(next, iterations * 10));
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    std::printf("%-52s %12s %14s %12s\n", "benchmark", "iterations", "ns/op", "allocs/op");
+    for (const Benchmark& benchmark : allBenchmarks()) {
+        if (filter && benchmark.name.find(filter) == std::string::npos) continue;
+
+        BenchState result = runBenchmark(benchmark);
+        double nsPerOp = result.getElapsed() * 1e9 / result.getIterations();
+        double allocsPerOp = static_cast<double>(result.getAllocations()) / result.getIterations();
+        std::printf("%-52s %12llu %14.1f %12.2f\n", benchmark.name.c_str(),
+                    static_cast<unsigned long long>(result.getIterations()), nsPerOp, allocsPerOp);
+        std::fflush(stdout);
+    }
+    return 0;
+}